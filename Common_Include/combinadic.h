@@ -0,0 +1,178 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<vector>
+#include<limits>
+#include<cstddef>
+#include<cstdint>
+#include"parallel_for.h"
+#include"frame_arena.h"
+
+// The combinatorial number system.  A k-combination of the elements [0..n) is
+// held as its elements in increasing order, c[0] < c[1] < ... < c[k-1], and
+// its rank is the sum of C(c[i], i + 1).  Ranks count combinations in colex
+// order, i.e. ordered by their largest element first, and do not depend on n.
+namespace combinadic {
+
+using Combination = std::vector<unsigned>;
+
+// An unsigned integer of any size, as 32-bit limbs, least significant first,
+// for ranks of more combinations than 64 bits count.
+using Rank = std::vector<std::uint32_t>;
+
+// Set the combination to the first k-combination, [0..k).
+void first(Combination& out, unsigned k);
+
+// Advance the combination to the next k-combination of n elements in
+// constant amortized time.  Returns the index of the last element altered, or
+// the combination's size when it was the last one, in which case it restarts
+// from the first.
+unsigned increment(Combination& inout, unsigned n);
+
+// Return C(n, k), or the largest 64-bit value when it does not fit.
+std::uint64_t binomial(unsigned n, unsigned k);
+
+// Return the rank of the combination.  Its rank must fit in 64 bits.
+std::uint64_t rank(Combination const& in);
+
+// Set the first argument to the k-combination of n elements of the given
+// rank, which must be less than C(n, k).
+void unrank(Combination& out, std::uint64_t rank, unsigned n, unsigned k);
+
+// Arbitrary precision forms of the above.
+void binomial(Rank& out, unsigned n, unsigned k);
+void rank(Rank& out, Combination const& in);
+void unrank(Combination& out, Rank rank, unsigned n, unsigned k);
+
+// Rank arithmetic.  Results are kept without leading zero limbs.
+void to_rank(Rank& out, std::uint64_t in);
+std::uint64_t from_rank(Rank const& in);    // The low 64 bits.
+void add(Rank& inout, Rank const& in);
+void subtract(Rank& inout, Rank const& in); // The first may not be less.
+int compare(Rank const& first, Rank const& second);
+void multiply(Rank& inout, std::uint32_t multiplier);
+std::uint32_t divide(Rank& inout, std::uint32_t divisor); // Returns remainder.
+
+// Set the first argument to the rank the given shard of shards begins at when
+// the k-combinations of n are split into shards contiguous rank ranges of
+// near equal size.  Shard `shards` gives the end of the last.  shards must
+// fit in 32 bits.
+void shard(Rank& out, unsigned n, unsigned k, std::size_t shard, std::size_t shards);
+
+// Invoke visit(combination) on count k-combinations of n in colex order,
+// starting from the one of the given rank.
+template<typename Visit_>
+void for_each( unsigned n, unsigned k
+             , std::uint64_t first, std::uint64_t count
+             , Visit_ visit) {
+
+    if(!count)
+        return;
+
+    Combination combination;
+    unrank(combination, first, n, k);
+
+    do
+        visit(static_cast<Combination const&>(combination));
+    while(--count && increment(combination, n) < k);
+}
+
+// Invoke visit(combination) on every k-combination of n, split by rank
+// range over the given number of threads (0 for the hardware concurrency).
+// visit is called concurrently and the count of combinations must fit in
+// 64 bits.
+template<typename Visit_>
+void parallel_for_each(unsigned n, unsigned k, Visit_ visit, unsigned threads = 0) {
+
+    factorial_base::parallel_for( std::size_t(binomial(n, k))
+                                , [&](std::size_t first, std::size_t last) {
+                                      for_each(n, k, first, last - first, visit);
+                                  }
+                                , threads);
+}
+
+// Bit mask combinations, for n of at most 64.  Element i is selected by bit i,
+// and Gosper's hack steps through masks with k bits set in colex order.
+
+inline std::uint64_t first_mask(unsigned k) {
+    return k < 64 ? (std::uint64_t(1) << k) - 1 : ~std::uint64_t(0);
+}
+
+// Advance the mask to the next with as many bits set below bit n.  Returns
+// false, leaving the mask unchanged, when it was the last.
+inline bool next_mask(std::uint64_t& inout, unsigned n) {
+
+    if(!inout)
+        return false;
+
+    // The lowest run of set bits moves up past its top bit, which is
+    // carried into the next clear bit, and the rest of the run restarts at
+    // bit 0.
+    auto const lowest = inout & (0 - inout),
+               carried = inout + lowest;
+
+    if(!carried)
+        return false;
+
+    auto const next = carried | (((carried ^ inout) >> 2) / lowest);
+
+    if(n < 64 && next >> n)
+        return false;
+
+    inout = next;
+    return true;
+}
+
+std::uint64_t to_mask(Combination const& in);
+void from_mask(Combination& out, std::uint64_t in);
+
+// Return a yield generator enumerating the k-permutations of the string
+// provided, each of its k-combinations in colex order permuted in turn by
+// permute(selection), e.g. lexicographic_permutation or single swap
+// iterate.  As those enumerators do, permute yields every permutation of the
+// selection but the selection itself, which is yielded first.  With a
+// lexicographic permute, the k-permutation of rank r * k! + s is permutation s
+// of combination r.
+template<typename Permute_>
+frame_arena::generator<std::string>
+k_permutations(std::string in, unsigned k, Permute_ permute) {
+
+    auto const n = unsigned(in.size());
+    if(k > n)
+        co_return;
+
+    Combination selection;
+    first(selection, k);
+
+    std::string selected(k, '\0');
+
+    do {
+        for(unsigned i = 0; i < k; ++i)
+            selected[i] = in[selection[i]];
+
+        co_yield selected;
+
+        for(auto const& permutation : permute(selected))
+            co_yield permutation;
+
+    } while(increment(selection, n) < k);
+}
+
+}
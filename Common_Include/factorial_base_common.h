@@ -18,6 +18,7 @@
 
 #pragma once
 #include<vector>
+#include<cstddef>
 
 namespace factorial_base {
 
@@ -26,4 +27,9 @@ namespace factorial_base {
 // number's value of d_i * i!.  Each d_i runs from 0 through i.
 using Number = std::vector<unsigned>;
 
+// Return n!, usable in constant expressions.
+constexpr std::size_t factorial(std::size_t n) {
+    return n > 1 ? n * factorial(n - 1) : 1;
+}
+
 }
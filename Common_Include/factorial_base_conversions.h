@@ -19,6 +19,7 @@
 #pragma once
 
 #include<vector>
+#include<cstdint>
 #include"factorial_base_common.h"
 
 namespace factorial_base {
@@ -31,4 +32,29 @@ namespace factorial_base {
     // unsigned value.
     unsigned from_factorial_base(Number const& in);
 
+    // Transform the 64-bit argument into a factorial base number of exactly
+    // the given number of digits.  The argument must be less than
+    // (digits + 1)!.
+    void to_factorial_base64(Number& out, std::uint64_t in, std::size_t digits);
+
+    // Transform the factorial base number in the argument into a 64-bit value.
+    // The number may hold at most 20 digits.
+    std::uint64_t from_factorial_base64(Number const& in);
+
+    // Batch forms of the two above over a flat digit matrix: row r of the
+    // matrix, digits bytes from r * digits, holds the digits of number r,
+    // least significant first.  digits is at most 20 and each number
+    // less than (digits + 1)!.  Division by each radix is a multiply-shift by
+    // its reciprocal, four numbers to a vector register where SSE2 is
+    // available.
+    void to_factorial_base64( std::uint8_t*        out
+                            , std::uint64_t const* in
+                            , std::size_t          count
+                            , std::size_t          digits);
+
+    void from_factorial_base64( std::uint64_t*       out
+                              , std::uint8_t const*  in
+                              , std::size_t          count
+                              , std::size_t          digits);
+
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 #include"factorial_base_common.h"
+#include<cstdint>
 
 namespace factorial_base {
 
@@ -25,4 +26,27 @@ namespace factorial_base {
 // Returns the index of the last digit altered.
 unsigned increment(Number& inout);
 
+// Add the second argument to the first.  As with increment(), a carry out of
+// the most significant digit becomes a new most significant digit.
+void add(Number& inout, Number const& in);
+void add(Number& inout, std::uint64_t in);
+
+// Subtract the second argument from the first, which must not be the lesser.
+// The first keeps its number of digits.
+void subtract(Number& inout, Number const& in);
+
+// Return a negative, zero or positive value as the first argument is less
+// than, equal to or greater than the second.  Leading zero digits are
+// ignored.
+int compare(Number const& first, Number const& second);
+
+// Divide the factorial base number by the second argument, returning the
+// remainder.
+unsigned divide(Number& inout, unsigned divisor);
+
+// Set the first argument to the largest stride at which count ranks fit in
+// the size! permutations of size elements, i.e. size! / count, but at least
+// 1.
+void spread(Number& out, std::size_t size, unsigned count);
+
 }
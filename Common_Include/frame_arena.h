@@ -0,0 +1,109 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<experimental\generator>
+#include<memory>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+// Coroutine frame allocation from per thread arenas.
+//
+// std::experimental::generator's promise allocates its coroutine frame with
+// the generator's allocator type.  frame_arena::allocator draws frames from
+// the arena bound to the calling thread by a frame_arena::scope, or from the
+// heap when none is bound, so every frame an enumerator creates within one
+// scope comes from one arena and is released with it in bulk.  An arena must
+// outlive the generators whose frames it holds.
+namespace frame_arena {
+
+// A bump allocator handing out memory from large blocks.  Individual
+// deallocations are ignored; all blocks are freed on destruction.
+class arena {
+public:
+    explicit arena(std::size_t block_size = 4096);
+
+    // Disallow copy and move
+    arena(arena const&) = delete;
+    arena(arena&&) = delete;
+    arena& operator=(arena const&) = delete;
+    arena& operator=(arena&&) = delete;
+
+    void* allocate(std::size_t bytes);
+
+    std::size_t allocations() const { return allocations_; }    // served
+    std::size_t bytes() const { return bytes_; }                // served
+    std::size_t blocks() const { return blocks_.size(); }       // from heap
+
+private:
+    std::size_t                           block_size_;
+    std::vector<std::unique_ptr<char[]>>  blocks_;
+    char*                                 next_      { nullptr };
+    std::size_t                           remaining_ { 0 };
+    std::size_t                           allocations_ { 0 },
+                                          bytes_       { 0 };
+};
+
+// Return the arena bound to the calling thread, or nullptr.
+arena* current();
+
+// Binds an arena to the calling thread for the lifetime of this object,
+// restoring the previous binding afterwards.
+class scope {
+public:
+    explicit scope(arena& bound);
+    ~scope();
+
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+
+private:
+    arena* previous_;
+};
+
+// Allocate a frame from the bound arena or the heap.  The owning arena, if
+// any, is recorded ahead of the frame so deallocation needs no binding.
+void* allocate_frame(std::size_t bytes);
+void deallocate_frame(void* frame);
+
+// A stateless allocator suitable as std::experimental::generator's allocator.
+template<typename T>
+struct allocator {
+    using value_type = T;
+
+    allocator() = default;
+    template<typename U> allocator(allocator<U> const&) { }
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(allocate_frame(count * sizeof(T)));
+    }
+
+    void deallocate(T* frame, std::size_t) {
+        deallocate_frame(frame);
+    }
+
+    template<typename U> bool operator==(allocator<U> const&) const { return true; }
+    template<typename U> bool operator!=(allocator<U> const&) const { return false; }
+};
+
+// A generator whose frame is allocated as described above.
+template<typename T>
+using generator = std::experimental::generator<T, allocator<char>>;
+
+}
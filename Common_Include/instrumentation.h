@@ -0,0 +1,101 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Opt-in hot path instrumentation.  Define PERMUTATIONS_INSTRUMENT to enable
+// it; otherwise the INSTRUMENT_* macros below expand to nothing and their
+// arguments are never evaluated.
+//
+// Counts are kept per thread and summed by snapshot_json(), those of exited
+// threads having been folded into one retired total.  Named stages
+// record their call count and elapsed time and, on Linux once
+// enable_hardware_counters() has been called, CPU cycles and cache misses
+// read with perf_event_open.
+
+#include<string>
+#include<cstdint>
+#include<chrono>
+
+namespace instrumentation {
+
+// The event counts kept per thread.
+enum counter_id {
+    increments,         // calls to factorial_base::increment
+    permutations,       // permutations yielded by the enumerators
+    resumes,            // coroutine resumptions
+    frames,             // coroutine frames allocated
+    frame_bytes,        // bytes of coroutine frames allocated
+    heap_allocations,   // heap allocations made for coroutine frames
+    heap_bytes,         // bytes of the above
+    counter_count
+};
+
+// The largest carry depth recorded separately; deeper carries share its bin.
+unsigned const max_carry_depth = 32;
+
+// Add to one of the calling thread's counts.
+void count(counter_id id, std::uint64_t amount = 1);
+
+// Record the index of the last digit factorial_base::increment altered.
+void carry(unsigned depth);
+
+// Request cycle and cache miss counts for stages started afterwards on any
+// thread.  Returns false where perf_event_open is unavailable.
+bool enable_hardware_counters();
+
+// Times the enclosing scope as a named stage.
+class stage_timer {
+public:
+    explicit stage_timer(std::string name);
+    ~stage_timer();
+
+    stage_timer(stage_timer const&) = delete;
+    stage_timer& operator=(stage_timer const&) = delete;
+
+private:
+    std::string                                    name_;
+    std::chrono::steady_clock::time_point          start_;
+    std::uint64_t                                  cycles_,
+                                                   cache_misses_;
+};
+
+// Return the counts of all threads so far as a JSON object.
+std::string snapshot_json();
+
+// Zero the counts of all threads.
+void reset();
+
+}
+
+#if defined(PERMUTATIONS_INSTRUMENT)
+#   define INSTRUMENT_COUNT(id, amount) \
+        ::instrumentation::count(::instrumentation::id, amount)
+#   define INSTRUMENT_CARRY(depth) ::instrumentation::carry(depth)
+#   define INSTRUMENT_STAGE_NAME_(line) instrument_stage_##line
+#   define INSTRUMENT_STAGE_NAME(line) INSTRUMENT_STAGE_NAME_(line)
+#   define INSTRUMENT_STAGE(name) \
+        ::instrumentation::stage_timer INSTRUMENT_STAGE_NAME(__LINE__)(name)
+#   define INSTRUMENT_REPORT(stream) \
+        ((stream) << ::instrumentation::snapshot_json() << '\n')
+#else
+#   define INSTRUMENT_COUNT(id, amount) ((void)0)
+#   define INSTRUMENT_CARRY(depth) ((void)0)
+#   define INSTRUMENT_STAGE(name) ((void)0)
+#   define INSTRUMENT_REPORT(stream) ((void)0)
+#endif
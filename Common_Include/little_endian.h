@@ -0,0 +1,52 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<cstdint>
+#include<ostream>
+
+// Little endian serialization of unsigned integers of 1 to 8 bytes, as the
+// projects' file and wire formats store them.
+namespace little_endian {
+
+inline void put(std::uint8_t* out, std::uint64_t value, unsigned bytes) {
+    for(unsigned i = 0; i < bytes; ++i, value >>= 8)
+        out[i] = std::uint8_t(value & 0xFF);
+}
+
+inline void put(char* out, std::uint64_t value, unsigned bytes) {
+    put(reinterpret_cast<std::uint8_t*>(out), value, bytes);
+}
+
+inline void put(std::ostream& out, std::uint64_t value, unsigned bytes) {
+    for(unsigned i = 0; i < bytes; ++i, value >>= 8)
+        out.put(char(value & 0xFF));
+}
+
+inline std::uint64_t get(std::uint8_t const* in, unsigned bytes) {
+    std::uint64_t value = 0;
+    for(unsigned i = bytes; i--; )
+        value = (value << 8) | in[i];
+    return value;
+}
+
+inline std::uint64_t get(char const* in, unsigned bytes) {
+    return get(reinterpret_cast<std::uint8_t const*>(in), bytes);
+}
+
+}
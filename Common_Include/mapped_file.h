@@ -0,0 +1,73 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<cstddef>
+#include<cstdint>
+
+// A whole file mapped into memory, read only or, for a newly created file of
+// a given size, read write.  The mapping is released on destruction.
+class mapped_file {
+public:
+
+    // Map an existing file for reading.
+    explicit mapped_file(std::string const& path);
+
+    // Create or truncate a file of the given size and map it for writing.
+    mapped_file(std::string const& path, std::uint64_t bytes);
+
+    ~mapped_file();
+
+    // Disallow copy and move
+    mapped_file(mapped_file const&) = delete;
+    mapped_file(mapped_file&&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file&&) = delete;
+
+    bool is_open() const { return data_ != nullptr; }
+
+    std::uint8_t const* data() const { return data_; }
+
+    // The mapping of a file opened for writing, otherwise nullptr.
+    std::uint8_t* writable_data() const { return writable_ ? data_ : nullptr; }
+
+    std::size_t size() const { return bytes_; }
+
+    // Ask for the mapping to be backed by huge pages where the platform
+    // supports it for files.  Returns false otherwise.
+    bool advise_huge_pages();
+
+    // Write modified pages back to the file.  Returns false on failure.
+    bool flush();
+
+private:
+
+    // Map size bytes of the open file.
+    void map(std::size_t bytes);
+
+    std::uint8_t* data_     { nullptr };
+    std::size_t   bytes_    { 0 };
+    bool          writable_ { false };
+#if defined(_WIN32)
+    void*         file_     { nullptr };    // file and mapping handles
+    void*         mapping_  { nullptr };
+#else
+    int           file_     { -1 };
+#endif
+};
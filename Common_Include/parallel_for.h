@@ -0,0 +1,58 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<thread>
+#include<vector>
+#include<algorithm>
+#include<cstddef>
+
+namespace factorial_base {
+
+// Split the range [0..count) into contiguous shards, one per thread, and
+// invoke work(first, last) on each shard concurrently.  A thread count of 0
+// selects the hardware concurrency.  Small ranges run on the calling thread.
+template<typename Work_>
+void parallel_for(std::size_t count, Work_ work, unsigned threads = 0) {
+
+    if(!threads)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+
+    std::size_t const shards = std::min<std::size_t>(threads, count);
+
+    if(shards <= 1) {
+        work(std::size_t(0), count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(shards - 1);
+
+    // The calling thread takes the last shard.
+    for(std::size_t shard = 0; shard + 1 < shards; ++shard)
+        workers.emplace_back( work
+                            , count * shard / shards
+                            , count * (shard + 1) / shards);
+
+    work(count * (shards - 1) / shards, count);
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+}
@@ -0,0 +1,109 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"parallel_for.h"
+#include<vector>
+#include<utility>
+#include<cassert>
+#include<cstddef>
+#include<cstdint>
+
+// Application, composition, inversion and cycles of permutations of any
+// size, as index lists: element i holds the index of the source position
+// moved to position i, as small_permutation's Shuffle does.
+//
+// Gathers and scatters are plain loops, split over threads by range once
+// the permutation has millions of elements.  Gathering by blocks of the
+// source in separate passes was measured and lost to the plain loop at every
+// size tried, up to a source nearly twice the last level cache, so it is
+// not done.
+namespace permutation_algebra {
+
+using Index = unsigned;
+
+// Permutations of fewer elements run on the calling thread alone.
+std::size_t const parallel_size  = std::size_t(1) << 20;
+
+// Gather n elements, out[i] = in[p[i]].  out and in may not overlap.  A
+// thread count of 0 selects the hardware concurrency.
+template<typename T>
+void apply( T* out, T const* in, Index const* p, std::size_t n
+          , unsigned threads = 0) {
+
+    assert(!n || out != in);
+
+    factorial_base::parallel_for(n, [=](std::size_t first, std::size_t last) {
+                                        for(auto i = first; i < last; ++i)
+                                            out[i] = in[p[i]];
+                                    }
+                                , n < parallel_size ? 1 : threads);
+}
+
+// Gather in place, following each cycle of the permutation once, so only
+// one element is held aside at a time.  A bitmap marks the positions done.
+template<typename T>
+void apply_in_place(T* inout, Index const* p, std::size_t n) {
+
+    std::vector<std::uint64_t> done((n + 63) / 64, 0);
+
+    for(std::size_t start = 0; start < n; ++start) {
+
+        if(done[start / 64] >> (start % 64) & 1 || p[start] == start)
+            continue;
+
+        T held = std::move(inout[start]);
+
+        for(auto i = start; ; ) {
+
+            done[i / 64] |= std::uint64_t(1) << (i % 64);
+            std::size_t const source = p[i];
+
+            if(source == start) {
+                inout[i] = std::move(held);
+                break;
+            }
+
+            inout[i] = std::move(inout[source]);
+            i = source;
+        }
+    }
+}
+
+// Compose two permutations so that applying the result equals applying first
+// and then second, i.e. out[i] = first[second[i]].  out may not overlap
+// either.
+void compose( Index* out, Index const* first, Index const* second
+            , std::size_t n, unsigned threads = 0);
+
+// Invert the permutation, out[p[i]] = i.  out and p may not overlap.
+void invert(Index* out, Index const* p, std::size_t n, unsigned threads = 0);
+
+// Decompose the permutation into its cycles, fixed points included, each
+// listed as s, p[s], p[p[s]], ... from its least element s, in order of
+// those.  Cycle c is elements [starts[c]..starts[c + 1]); starts ends with
+// n.  Returns the number of cycles.
+std::size_t cycles( std::vector<Index>&       elements
+                  , std::vector<std::size_t>& starts
+                  , Index const*              p
+                  , std::size_t               n);
+
+// Test that the n indices are a permutation of [0..n).
+bool is_permutation(Index const* p, std::size_t n);
+
+}
@@ -0,0 +1,320 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"span.h"
+#include<atomic>
+#include<condition_variable>
+#include<exception>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+#include<algorithm>
+#include<utility>
+#include<cstddef>
+#include<cstdint>
+
+// Producer/consumer pipelines for the enumerators.  A producer fills blocks
+// of items, which consumer threads take and return for reuse.  Blocks travel
+// between the two sides through lock-free bounded queues, and with a fixed
+// number of blocks a producer outrunning its consumers waits for a block to
+// be returned rather than allocating another.  Either side finding its queue
+// empty sleeps until the other hands it a block.
+namespace pipeline {
+
+// A bounded multi-producer multi-consumer queue after Dmitry Vyukov.  Each
+// cell's sequence number tells whether it awaits a push or a pop for the
+// current lap of the ring, so neither side takes a lock.
+template<typename T>
+class bounded_queue {
+public:
+
+    // The capacity is rounded up to a power of two.
+    explicit bounded_queue(std::size_t capacity) {
+
+        std::size_t size = 2;
+        while(size < capacity)
+            size <<= 1;
+
+        mask_ = size - 1;
+        cells_.reset(new cell[size]);
+        for(std::size_t i = 0; i < size; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bounded_queue(bounded_queue const&) = delete;
+    bounded_queue& operator=(bounded_queue const&) = delete;
+
+    // Return false when the queue is full.
+    bool try_push(T const& value) {
+
+        cell* target;
+        auto position = enqueue_.load(std::memory_order_relaxed);
+
+        for(;;) {
+            target = &cells_[position & mask_];
+            auto const sequence = target->sequence.load(std::memory_order_acquire);
+            auto const lap = std::intptr_t(sequence) - std::intptr_t(position);
+
+            if(!lap) {
+                if(enqueue_.compare_exchange_weak( position, position + 1
+                                                 , std::memory_order_relaxed))
+                    break;
+            } else if(lap < 0)
+                return false;
+            else
+                position = enqueue_.load(std::memory_order_relaxed);
+        }
+
+        target->value = value;
+        target->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Return false when the queue is empty.
+    bool try_pop(T& value) {
+
+        cell* source;
+        auto position = dequeue_.load(std::memory_order_relaxed);
+
+        for(;;) {
+            source = &cells_[position & mask_];
+            auto const sequence = source->sequence.load(std::memory_order_acquire);
+            auto const lap = std::intptr_t(sequence) - std::intptr_t(position + 1);
+
+            if(!lap) {
+                if(dequeue_.compare_exchange_weak( position, position + 1
+                                                 , std::memory_order_relaxed))
+                    break;
+            } else if(lap < 0)
+                return false;
+            else
+                position = dequeue_.load(std::memory_order_relaxed);
+        }
+
+        value = source->value;
+        source->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        T                        value;
+    };
+
+    std::unique_ptr<cell[]>              cells_;
+    std::size_t                          mask_;
+    alignas(64) std::atomic<std::size_t> enqueue_ { 0 };
+    alignas(64) std::atomic<std::size_t> dequeue_ { 0 };
+};
+
+// A fixed set of reusable blocks circulating between producers and
+// consumers.  Items left in a block are assigned over on reuse, so strings
+// keep their capacity and no allocation is made once the ring is warm.
+template<typename T>
+class ring {
+public:
+
+    struct block {
+        std::vector<T> items;
+        std::size_t    count { 0 };
+    };
+
+    ring(std::size_t blocks, std::size_t block_size)
+    : blocks_(blocks)
+    , free_(blocks)
+    , full_(blocks) {
+        for(auto& b : blocks_) {
+            b.items.resize(block_size);
+            free_.try_push(&b);
+        }
+    }
+
+    std::size_t block_size() const { return blocks_.front().items.size(); }
+
+    // Take an empty block, waiting for one to be released if need be.
+    block* acquire() {
+        block* b;
+        if(!free_.try_pop(b)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            released_.wait(lock, [&]() { return free_.try_pop(b); });
+        }
+        b->count = 0;
+        return b;
+    }
+
+    // Hand a filled block to the consumers.  Both queues hold every block,
+    // so pushes always succeed.
+    void publish(block* b) {
+        full_.try_push(b);
+        wake(published_);
+    }
+
+    // Take a filled block, waiting for one to be published.  Returns nullptr
+    // once the ring is closed and drained.
+    block* consume() {
+        block* b;
+        if(full_.try_pop(b))
+            return b;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool taken = false;
+        published_.wait(lock, [&]() {
+                                  taken = full_.try_pop(b);
+                                  return taken || closed_;
+                              });
+        return taken ? b : nullptr;
+    }
+
+    // Return a consumed block for reuse.
+    void release(block* b) {
+        free_.try_push(b);
+        wake(released_);
+    }
+
+    // Signal that nothing more will be published.
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        published_.notify_all();
+    }
+
+private:
+
+    // Passing through the mutex orders the push before a waiter's next test.
+    void wake(std::condition_variable& waiters) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        waiters.notify_one();
+    }
+
+    std::vector<block>      blocks_;
+    bounded_queue<block*>   free_,
+                            full_;
+    std::mutex              mutex_;
+    std::condition_variable published_,
+                            released_;
+    bool                    closed_ { false };
+};
+
+struct options {
+    unsigned    consumers  = 0;     // consumer threads, 0 for a core apiece
+                                    // but the producer's
+    std::size_t block_size = 1024;  // items per block
+    std::size_t blocks     = 0;     // blocks in flight, 0 for 4 per consumer
+};
+
+// Run produce on the calling thread while consumer threads drain its output.
+// produce is invoked with an emit(T const&) function to call for each item.
+// consume is invoked concurrently with a span of items at a time, which are
+// only valid during the call.  Should either throw, the consumers are joined
+// and the first exception is rethrown; once a consumer has thrown, emit
+// rethrows it to the producer and the blocks still queued are skipped.
+template<typename T, typename Produce_, typename Consume_>
+void run(Produce_ produce, Consume_ consume, options settings = options()) {
+
+    if(!settings.consumers)
+        settings.consumers
+            = std::max(2U, std::thread::hardware_concurrency()) - 1;
+    if(!settings.blocks)
+        settings.blocks = 4 * std::size_t(settings.consumers);
+    settings.block_size = std::max<std::size_t>(1, settings.block_size);
+
+    ring<T> blocks(std::max<std::size_t>(2, settings.blocks), settings.block_size);
+
+    // The first exception a consumer throws.
+    std::mutex          error_mutex;
+    std::exception_ptr  error;
+    std::atomic<bool>   failed { false };
+
+    std::vector<std::thread> consumers;
+    consumers.reserve(settings.consumers);
+
+    // Close the ring and join the consumers however the producer leaves.
+    struct joiner {
+        ring<T>&                  blocks;
+        std::vector<std::thread>& threads;
+        ~joiner() {
+            blocks.close();
+            for(auto& thread : threads)
+                thread.join();
+        }
+    } joined { blocks, consumers };
+
+    for(unsigned i = 0; i < settings.consumers; ++i)
+        consumers.emplace_back([&]() {
+            while(auto b = blocks.consume()) {
+                if(!failed.load(std::memory_order_acquire))
+                    try {
+                        consume(factorial_base::span<T const>( b->items.data()
+                                                             , b->count));
+                    } catch(...) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if(!error)
+                            error = std::current_exception();
+                        failed.store(true, std::memory_order_release);
+                    }
+                blocks.release(b);
+            }
+        });
+
+    auto current = blocks.acquire();
+
+    produce([&](T const& item) {
+        if(failed.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            std::rethrow_exception(error);
+        }
+        current->items[current->count++] = item;
+        if(current->count == current->items.size()) {
+            blocks.publish(current);
+            current = blocks.acquire();
+        }
+    });
+
+    if(current->count)
+        blocks.publish(current);
+    else
+        blocks.release(current);
+
+    blocks.close();
+
+    for(auto& consumer : consumers)
+        consumer.join();
+    consumers.clear();
+
+    if(error)
+        std::rethrow_exception(error);
+}
+
+// Run the pipeline over the items of a range, such as an enumerator's
+// generator, iterated on the calling thread.
+template<typename T, typename Range_, typename Consume_>
+void drain(Range_&& items, Consume_ consume, options settings = options()) {
+    run<T>( [&items](auto emit) {
+                for(auto const& item : items)
+                    emit(item);
+            }
+          , consume
+          , settings);
+}
+
+}
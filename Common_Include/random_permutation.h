@@ -0,0 +1,118 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+#include"factorial_base_common.h"
+
+// Uniformly distributed random permutations drawn as factorial base digits.
+// Each digit is a bounded random integer.  Consecutive digits are taken from
+// one 64-bit random word by Lemire's multiply-shift: multiplying the word by
+// a digit's radix leaves the digit in the high half and a fresh fraction in
+// the low half for the next digit.  Chaining the digits this way is one
+// multiply-shift by the product of their radices, so a single rejection test
+// on the final fraction keeps them unbiased.  Up to 20 elements, all digits
+// come from a single word.  The digits are then unranked as a lexicographic
+// permutation state.
+namespace random_permutation {
+
+// The largest permutation of byte indices sampled.
+std::size_t const max_size = 256;
+
+// The xoshiro256** generator.  Separate streams are 2^128 draws apart.
+class engine {
+public:
+    using result_type = std::uint64_t;
+
+    // Seed the generator and advance it to the given stream.
+    explicit engine(std::uint64_t seed, std::uint64_t stream = 0);
+
+    result_type operator()();
+
+    // Advance 2^128 draws, i.e. to the next stream.
+    void jump();
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+private:
+    std::uint64_t state_[4];
+};
+
+// Draws permutations of a fixed size.  Each thread should own its sampler,
+// seeded with a shared seed and its own stream for reproducible parallel
+// runs.
+class sampler {
+public:
+    sampler(std::size_t size, std::uint64_t seed, std::uint64_t stream = 0);
+
+    std::size_t size() const { return size_; }
+
+    // Draw a uniformly distributed permutation state.
+    factorial_base::Number const& draw();
+
+    // Draw a permutation into the index list provided, of size() elements,
+    // where element i holds the original position moved to position i.
+    void sample(unsigned char* out);
+
+    // Draw count permutations into consecutive rows of size() elements.
+    void sample(unsigned char* rows, std::size_t count);
+
+    // Draw a permutation of the string provided, of size() characters.
+    void sample(std::string& out, std::string const& in);
+
+    engine& random() { return random_; }
+
+private:
+
+    // Digits [first..last) drawn from one random word, whose radices have
+    // the product given.  Fractions below threshold, 2^64 mod product, are
+    // rejected.
+    struct group {
+        unsigned      first,
+                      last;
+        std::uint64_t product,
+                      threshold;
+    };
+
+    // Convert the drawn state into an index list.
+    void unrank(unsigned char* out) const;
+
+    std::size_t            size_;
+    engine                 random_;
+    std::vector<group>     groups_;
+    factorial_base::Number state_;
+};
+
+// The rows drawn from each stream by sample_batch().
+std::size_t const batch_stream_rows = 65536;
+
+// Draw count permutations of size elements into consecutive rows, split
+// across the given number of threads (0 for all cores).  Each block of
+// batch_stream_rows rows is drawn from its own stream of the seed, so the
+// result does not depend on the thread count.
+void sample_batch( std::size_t    size
+                 , std::uint64_t  seed
+                 , unsigned char* rows
+                 , std::size_t    count
+                 , unsigned       threads = 0);
+
+}
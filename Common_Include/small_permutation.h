@@ -0,0 +1,93 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include"factorial_base_common.h"
+
+namespace small_permutation {
+
+// The largest permutation held by a Shuffle, i.e. the byte width of one
+// SSE register.
+std::size_t const max_size = 16;
+
+// A permutation of up to max_size byte indices held in the layout of one
+// vector register.  Element i holds the index of the source position moved to
+// position i.  Elements at and past the permutation's size hold themselves so
+// the whole register can always be shuffled at once.
+struct alignas(16) Shuffle {
+    std::uint8_t index[max_size];
+};
+
+// Return true when the byte shuffle instruction (SSSE3 pshufb) was detected at
+// runtime and the functions below use it.  Otherwise they fall back to
+// portable scalar loops with identical results.
+bool accelerated();
+
+// Set the argument to the identity permutation.
+void identity(Shuffle& out);
+
+// Convert the factorial base number in the second argument into the
+// lexicographic permutation it selects, as lexicographic_permutation() does.
+// The permutation's size is one more than the number's, at most max_size.
+void unrank_lexicographic(Shuffle& out, factorial_base::Number const& state);
+
+// Arrange the size elements of in into out as the size - 1 factorial base
+// digits provided, least significant first, select lexicographically: the
+// element at the most significant digit's index first, each erased from
+// those remaining.  A scalar loop for permutations of any size; out and in
+// may be the same buffer.
+template<typename T, typename Digit_>
+void unrank_lexicographic( T*             out
+                         , T const*       in
+                         , Digit_ const*  digits
+                         , std::size_t    size) {
+
+    if(out != in)
+        std::copy(in, in + size, out);
+
+    // Positions from position on hold the elements remaining, in order.
+    for(std::size_t position = 0; position + 1 < size; ++position) {
+        auto const digit  = std::size_t(digits[size - 2 - position]);
+        auto const picked = out[position + digit];
+        std::copy_backward(out + position, out + position + digit, out + position + digit + 1);
+        out[position] = picked;
+    }
+}
+
+// Compose two permutations so that applying the result equals applying first
+// and then second, i.e. out[i] = first[second[i]].
+void compose(Shuffle& out, Shuffle const& first, Shuffle const& second);
+
+// Invert the permutation in the second argument.
+void invert(Shuffle& out, Shuffle const& in);
+
+// Exchange two positions of the permutation, as a single-swap step does.
+inline void swap(Shuffle& inout, unsigned i, unsigned j) {
+    std::uint8_t value = inout.index[i];
+    inout.index[i] = inout.index[j];
+    inout.index[j] = value;
+}
+
+// Permute the first size bytes of in into out, i.e. out[i] = in[p[i]].
+// size is at most max_size; out and in may be the same buffer.
+void apply(char* out, char const* in, Shuffle const& p, std::size_t size);
+
+}
@@ -0,0 +1,67 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<cstddef>
+#include<type_traits>
+#include<vector>
+#include<array>
+
+namespace factorial_base {
+
+// A non-owning view of a contiguous sequence of T.
+template<typename T>
+struct span {
+    using value_type = typename std::remove_const<T>::type;
+    using iterator   = T*;
+
+    T*          data_ { nullptr };
+    std::size_t size_ { 0 };
+
+    span() = default;
+    span(T* data, std::size_t size): data_(data), size_(size) { }
+
+    template<typename Alloc_>
+    span(std::vector<value_type, Alloc_>& in): data_(in.data()), size_(in.size()) { }
+
+    template<typename Alloc_>
+    span(std::vector<value_type, Alloc_> const& in): data_(in.data()), size_(in.size()) { }
+
+    template<std::size_t N_>
+    span(std::array<value_type, N_>& in): data_(in.data()), size_(N_) { }
+
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    T& operator[](std::size_t i) const { return data_[i]; }
+};
+
+// Elements which are cheaper to exchange directly than to track through an
+// index permutation: trivially copyable and no wider than two pointers.
+template<typename T>
+struct is_directly_permuted
+: std::integral_constant< bool
+                        , std::is_trivially_copyable<T>::value
+                          && sizeof(T) <= 2 * sizeof(void*) > {
+};
+
+}
@@ -0,0 +1,312 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/combinadic.h"
+#include<algorithm>
+#include<cassert>
+
+namespace combinadic {
+
+namespace {
+
+std::uint64_t gcd(std::uint64_t a, std::uint64_t b) {
+    while(b) {
+        auto const r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Return value * multiplier / divisor, known to be a whole number no larger
+// than value.  Common factors are divided out first so nothing overflows.
+std::uint64_t scale(std::uint64_t value, std::uint64_t multiplier, std::uint64_t divisor) {
+    auto const common = gcd(value, divisor);
+    return value / common * (multiplier / (divisor / common));
+}
+
+void trim(Rank& inout) {
+    while(!inout.empty() && !inout.back())
+        inout.pop_back();
+}
+
+}
+
+void first(Combination& out, unsigned k) {
+    out.resize(k);
+    for(unsigned i = 0; i < k; ++i)
+        out[i] = i;
+}
+
+// Advance the lowest element that has room below the element above it,
+// restarting those beneath it from 0.  Over all combinations the elements
+// restarted average a constant per step.
+unsigned increment(Combination& inout, unsigned n) {
+
+    auto const k = unsigned(inout.size());
+
+    for(unsigned i = 0; i < k; ++i) {
+
+        auto const limit = i + 1 < k ? inout[i + 1] : n;
+
+        if(inout[i] + 1 < limit) {
+            ++inout[i];
+            for(unsigned j = 0; j < i; ++j)
+                inout[j] = j;
+            return i;
+        }
+    }
+
+    first(inout, k);
+    return k;
+}
+
+std::uint64_t binomial(unsigned n, unsigned k) {
+
+    if(k > n)
+        return 0;
+
+    k = std::min(k, n - k);
+
+    // C(n - k + i, i) for i up to k, each step exact.
+    std::uint64_t result = 1;
+
+    for(unsigned i = 1; i <= k; ++i) {
+
+        auto const common = gcd(result, i),
+                   factor = (n - k + i) / (i / common);
+
+        if(result / common > std::numeric_limits<std::uint64_t>::max() / factor)
+            return std::numeric_limits<std::uint64_t>::max();
+
+        result = result / common * factor;
+    }
+
+    return result;
+}
+
+std::uint64_t rank(Combination const& in) {
+    std::uint64_t result = 0;
+    for(unsigned i = 0; i < in.size(); ++i)
+        result += binomial(in[i], i + 1);
+    return result;
+}
+
+// Take each element, largest first, as the largest v with C(v, i) not above
+// the rank remaining.  Candidates only decrease, so the binomials are stepped
+// rather than recomputed: C(v - 1, i) = C(v, i) (v - i) / v and, between
+// elements, C(v - 1, i - 1) = C(v, i) i / v.
+void unrank(Combination& out, std::uint64_t rank, unsigned n, unsigned k) {
+
+    assert(k <= n && rank < binomial(n, k));
+
+    out.resize(k);
+
+    unsigned v = n - 1;
+    auto b = binomial(v, k);
+
+    // Only C(n - 1, k) itself can exceed 64 bits, by less than C(n, k).
+    while(b == std::numeric_limits<std::uint64_t>::max() && b > rank)
+        b = binomial(--v, k);
+
+    for(unsigned i = k; i; --i) {
+
+        while(b > rank) {
+            b = scale(b, v - i, v);
+            --v;
+        }
+
+        out[i - 1] = v;
+        rank -= b;
+
+        if(i > 1) {
+            b = scale(b, i, v);
+            --v;
+        }
+    }
+}
+
+void binomial(Rank& out, unsigned n, unsigned k) {
+
+    out.clear();
+    if(k > n)
+        return;
+
+    k = std::min(k, n - k);
+    out.push_back(1);
+
+    for(unsigned i = 1; i <= k; ++i) {
+        multiply(out, n - k + i);
+        divide(out, i);
+    }
+}
+
+void rank(Rank& out, Combination const& in) {
+    out.clear();
+    Rank term;
+    for(unsigned i = 0; i < in.size(); ++i) {
+        binomial(term, in[i], i + 1);
+        add(out, term);
+    }
+}
+
+void unrank(Combination& out, Rank rank, unsigned n, unsigned k) {
+
+    assert(k <= n);
+    trim(rank);
+
+    out.resize(k);
+
+    unsigned v = n - 1;
+    Rank b;
+    binomial(b, v, k);
+
+    for(unsigned i = k; i; --i) {
+
+        while(compare(b, rank) > 0) {
+            multiply(b, v - i);
+            divide(b, v);
+            --v;
+        }
+
+        out[i - 1] = v;
+        subtract(rank, b);
+
+        if(i > 1) {
+            multiply(b, i);
+            divide(b, v);
+            --v;
+        }
+    }
+}
+
+void to_rank(Rank& out, std::uint64_t in) {
+    out.clear();
+    for(; in; in >>= 32)
+        out.push_back(std::uint32_t(in));
+}
+
+std::uint64_t from_rank(Rank const& in) {
+    std::uint64_t result = 0;
+    for(std::size_t i = std::min<std::size_t>(in.size(), 2); i--; )
+        result = result << 32 | in[i];
+    return result;
+}
+
+void add(Rank& inout, Rank const& in) {
+
+    if(inout.size() < in.size())
+        inout.resize(in.size(), 0);
+
+    std::uint64_t carry = 0;
+
+    for(std::size_t i = 0; i < inout.size() && (carry || i < in.size()); ++i) {
+        carry += std::uint64_t(inout[i]) + (i < in.size() ? in[i] : 0);
+        inout[i] = std::uint32_t(carry);
+        carry >>= 32;
+    }
+
+    if(carry)
+        inout.push_back(std::uint32_t(carry));
+}
+
+void subtract(Rank& inout, Rank const& in) {
+
+    assert(compare(inout, in) >= 0);
+
+    std::uint64_t borrow = 0;
+
+    for(std::size_t i = 0; i < inout.size() && (borrow || i < in.size()); ++i) {
+        auto const subtrahend = (i < in.size() ? in[i] : 0) + borrow;
+        borrow = inout[i] < subtrahend;
+        inout[i] = std::uint32_t(inout[i] + (borrow << 32) - subtrahend);
+    }
+
+    trim(inout);
+}
+
+int compare(Rank const& first, Rank const& second) {
+
+    for(auto i = std::max(first.size(), second.size()); i--; ) {
+
+        auto const a = i < first.size() ? first[i] : 0U,
+                   b = i < second.size() ? second[i] : 0U;
+
+        if(a != b)
+            return a < b ? -1 : 1;
+    }
+
+    return 0;
+}
+
+void multiply(Rank& inout, std::uint32_t multiplier) {
+
+    std::uint64_t carry = 0;
+
+    for(auto& limb : inout) {
+        carry += std::uint64_t(limb) * multiplier;
+        limb = std::uint32_t(carry);
+        carry >>= 32;
+    }
+
+    if(carry)
+        inout.push_back(std::uint32_t(carry));
+
+    trim(inout);
+}
+
+std::uint32_t divide(Rank& inout, std::uint32_t divisor) {
+
+    std::uint64_t remainder = 0;
+
+    for(auto i = inout.size(); i--; ) {
+        remainder = remainder << 32 | inout[i];
+        inout[i] = std::uint32_t(remainder / divisor);
+        remainder %= divisor;
+    }
+
+    trim(inout);
+    return std::uint32_t(remainder);
+}
+
+void shard(Rank& out, unsigned n, unsigned k, std::size_t shard, std::size_t shards) {
+
+    assert(shard <= shards && std::uint64_t(shards) >> 32 == 0);
+
+    binomial(out, n, k);
+    multiply(out, std::uint32_t(shard));
+    divide(out, std::uint32_t(shards));
+}
+
+std::uint64_t to_mask(Combination const& in) {
+    std::uint64_t result = 0;
+    for(auto element : in) {
+        assert(element < 64);
+        result |= std::uint64_t(1) << element;
+    }
+    return result;
+}
+
+void from_mask(Combination& out, std::uint64_t in) {
+    out.clear();
+    for(unsigned i = 0; in; ++i, in >>= 1)
+        if(in & 1)
+            out.push_back(i);
+}
+
+}
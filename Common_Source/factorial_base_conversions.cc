@@ -18,10 +18,170 @@
 
 #include"../Common_Include/factorial_base_conversions.h"
 #include<numeric>
+#include<algorithm>
 #include<cassert>
 
+#if defined(_M_X64) || defined(__SSE2__)
+#   include<emmintrin.h>
+#   define FACTORIAL_BASE_SSE2 1
+#endif
+
 namespace factorial_base {
 
+namespace {
+
+// Batch conversions split each 64-bit number into three parts of at most 29
+// bits by two scalar divisions: the digits of radices 2 to 12, of 13 to 18
+// and of 19 to 21.  Each part is then divided digit by digit in 32-bit lanes.
+std::uint64_t const low_product  = 479001600;   // 12!
+std::uint64_t const mid_product  = 13366080;    // 13 * 14 * ... * 18
+std::size_t const   low_digits   = 11;
+std::size_t const   mid_digits   = 6;
+std::size_t const   max_digits   = 20;
+
+// Numbers converted per pass, a multiple of the 16 lanes a pass stores.
+std::size_t const block = 256;
+
+// For n < 2^29, n / d = n * ceil(2^k / d) >> k where k = 29 + ceil(log2 d),
+// as the multiplier's excess over 2^k / d, below d / 2^k, cannot add up to a
+// whole unit.  The multiplier fits in 30 bits and the product in 59.
+struct reciprocal {
+    std::uint32_t multiplier;
+    unsigned      shift;
+};
+
+reciprocal make_reciprocal(unsigned d) {
+    unsigned k = 29;
+    while((1U << (k - 29)) < d)
+        ++k;
+    return reciprocal{ std::uint32_t(((std::uint64_t(1) << k) + d - 1) / d), k };
+}
+
+// The reciprocals of radices 2 to 21.
+struct reciprocals {
+    reciprocal radix[max_digits];
+
+    reciprocals() {
+        for(unsigned i = 0; i < max_digits; ++i)
+            radix[i] = make_reciprocal(i + 2);
+    }
+};
+
+reciprocals const& radix_reciprocals() {
+    static reciprocals const table;
+    return table;
+}
+
+#if defined(FACTORIAL_BASE_SSE2)
+
+// Multiply four 32-bit lanes by a 32-bit value, keeping 64-bit products of
+// the even lanes and of the odd lanes separately.
+inline void multiply_lanes(__m128i& even, __m128i& odd, __m128i values, __m128i by) {
+    even = _mm_mul_epu32(values, by);
+    odd  = _mm_mul_epu32(_mm_srli_epi64(values, 32), by);
+}
+
+// The low 32 bits of the even and odd products, as four lanes.
+inline __m128i low_lanes(__m128i even, __m128i odd) {
+    return _mm_or_si128( _mm_and_si128(even, _mm_set_epi32(0, -1, 0, -1))
+                       , _mm_slli_epi64(odd, 32));
+}
+
+// Replace each of four lanes by its quotient and return the remainders.
+inline __m128i divide_lanes(__m128i& values, reciprocal r, unsigned d) {
+
+    __m128i even, odd;
+    multiply_lanes(even, odd, values, _mm_set1_epi32(int(r.multiplier)));
+
+    auto const shift = _mm_cvtsi32_si128(int(r.shift));
+    auto const quotient = low_lanes(_mm_srl_epi64(even, shift), _mm_srl_epi64(odd, shift));
+
+    multiply_lanes(even, odd, quotient, _mm_set1_epi32(int(d)));
+    auto const remainder = _mm_sub_epi32(values, low_lanes(even, odd));
+
+    values = quotient;
+    return remainder;
+}
+
+// Divide n values, a multiple of 16, by d, leaving the quotients in place
+// and storing the remainders as bytes.
+void divide_column(std::uint32_t* values, std::uint8_t* digits, std::size_t n, unsigned d) {
+
+    auto const r = radix_reciprocals().radix[d - 2];
+
+    for(std::size_t i = 0; i < n; i += 16) {
+
+        __m128i lanes[4], remainders[4];
+
+        for(int j = 0; j < 4; ++j) {
+            lanes[j] = _mm_load_si128(reinterpret_cast<__m128i const*>(values + i + 4 * j));
+            remainders[j] = divide_lanes(lanes[j], r, d);
+            _mm_store_si128(reinterpret_cast<__m128i*>(values + i + 4 * j), lanes[j]);
+        }
+
+        _mm_store_si128( reinterpret_cast<__m128i*>(digits + i)
+                       , _mm_packus_epi16( _mm_packs_epi32(remainders[0], remainders[1])
+                                         , _mm_packs_epi32(remainders[2], remainders[3])));
+    }
+}
+
+// Horner's Rule step over n values, a multiple of 16: value * radix + digit.
+void horner_column(std::uint32_t* values, std::uint8_t const* digits, std::size_t n, unsigned radix) {
+
+    auto const by   = _mm_set1_epi32(int(radix));
+    auto const zero = _mm_setzero_si128();
+
+    for(std::size_t i = 0; i < n; i += 16) {
+
+        auto const bytes = _mm_load_si128(reinterpret_cast<__m128i const*>(digits + i));
+        auto const low   = _mm_unpacklo_epi8(bytes, zero),
+                   high  = _mm_unpackhi_epi8(bytes, zero);
+
+        __m128i const added[4] = { _mm_unpacklo_epi16(low, zero)
+                                 , _mm_unpackhi_epi16(low, zero)
+                                 , _mm_unpacklo_epi16(high, zero)
+                                 , _mm_unpackhi_epi16(high, zero) };
+
+        for(int j = 0; j < 4; ++j) {
+            auto const address = reinterpret_cast<__m128i*>(values + i + 4 * j);
+            __m128i even, odd;
+            multiply_lanes(even, odd, _mm_load_si128(address), by);
+            _mm_store_si128(address, _mm_add_epi32(low_lanes(even, odd), added[j]));
+        }
+    }
+}
+
+#else
+
+void divide_column(std::uint32_t* values, std::uint8_t* digits, std::size_t n, unsigned d) {
+
+    auto const r = radix_reciprocals().radix[d - 2];
+
+    for(std::size_t i = 0; i < n; ++i) {
+        auto const quotient = std::uint32_t((std::uint64_t(values[i]) * r.multiplier) >> r.shift);
+        digits[i] = std::uint8_t(values[i] - quotient * d);
+        values[i] = quotient;
+    }
+}
+
+void horner_column(std::uint32_t* values, std::uint8_t const* digits, std::size_t n, unsigned radix) {
+    for(std::size_t i = 0; i < n; ++i)
+        values[i] = values[i] * radix + digits[i];
+}
+
+#endif
+
+// The digits of each part: the first and past the last digit index.
+struct part {
+    std::size_t first, last;
+};
+
+part const parts[3] = { { 0, low_digits }
+                      , { low_digits, low_digits + mid_digits }
+                      , { low_digits + mid_digits, max_digits } };
+
+}
+
 // Transform the binary unsigned argument into a factorial base number
 // residing in the Number type argument.
 void to_factorial_base(Number& out, unsigned in) {
@@ -60,4 +220,109 @@ unsigned from_factorial_base(Number const& in) {
     return result;
 }
 
+// Transform the 64-bit argument into a factorial base number of exactly
+// the given number of digits.
+void to_factorial_base64(Number& out, std::uint64_t in, std::size_t digits) {
+
+    out.assign(digits, 0U);
+
+    for(unsigned i = 0; i < digits; ++i) {
+        out[i] = unsigned(in % (i + 2));
+        in /= i + 2;
+    }
+
+    assert(!in);
+}
+
+// Transform the factorial base number in the argument into a 64-bit value.
+std::uint64_t from_factorial_base64(Number const& in) {
+
+    assert(in.size() <= 20);
+
+    std::uint64_t base = in.size() + 1;
+
+    // Horner's Rule, as in from_factorial_base().
+    return std::accumulate( in.rbegin()
+                          , in.rend()
+                          , std::uint64_t(0)
+                          , [&base](std::uint64_t sum, unsigned value) {
+                                return sum * base-- + value;
+                            });
+}
+
+// Convert numbers a block at a time: split them into parts, divide the parts
+// column by column, then transpose the digit columns into rows.
+void to_factorial_base64( std::uint8_t*        out
+                        , std::uint64_t const* in
+                        , std::size_t          count
+                        , std::size_t          digits) {
+
+    assert(digits <= max_digits);
+
+    alignas(16) std::uint32_t values[3][block];
+    alignas(16) std::uint8_t  columns[max_digits][block];
+
+    for(std::size_t first = 0; first < count; first += block) {
+
+        auto const n = std::min(block, count - first),
+                   lanes = (n + 15) & ~std::size_t(15);
+
+        for(std::size_t i = 0; i < lanes; ++i) {
+
+            auto const number = i < n ? in[first + i] : 0;
+            assert(digits == max_digits || number < factorial(digits + 1));
+
+            auto const upper = number / low_product;
+            values[0][i] = std::uint32_t(number % low_product);
+            values[1][i] = std::uint32_t(upper % mid_product);
+            values[2][i] = std::uint32_t(upper / mid_product);
+        }
+
+        for(int p = 0; p < 3; ++p)
+            for(auto d = parts[p].first; d < std::min(parts[p].last, digits); ++d)
+                divide_column(values[p], columns[d], lanes, unsigned(d + 2));
+
+        auto row = out + first * digits;
+        for(std::size_t i = 0; i < n; ++i, row += digits)
+            for(std::size_t d = 0; d < digits; ++d)
+                row[d] = columns[d][i];
+    }
+}
+
+// Evaluate numbers a block at a time: transpose the rows into digit columns,
+// evaluate each part by Horner's Rule down the columns, then join the parts.
+void from_factorial_base64( std::uint64_t*       out
+                          , std::uint8_t const*  in
+                          , std::size_t          count
+                          , std::size_t          digits) {
+
+    assert(digits <= max_digits);
+
+    alignas(16) std::uint32_t values[3][block];
+    alignas(16) std::uint8_t  columns[max_digits][block];
+
+    for(std::size_t first = 0; first < count; first += block) {
+
+        auto const n = std::min(block, count - first),
+                   lanes = (n + 15) & ~std::size_t(15);
+
+        auto row = in + first * digits;
+        for(std::size_t i = 0; i < lanes; ++i, row += digits)
+            for(std::size_t d = 0; d < digits; ++d)
+                columns[d][i] = i < n ? row[d] : 0;
+
+        for(int p = 0; p < 3; ++p) {
+
+            std::fill_n(values[p], lanes, 0U);
+
+            for(auto d = std::min(parts[p].last, digits); d-- > parts[p].first; )
+                horner_column(values[p], columns[d], lanes, unsigned(d + 2));
+        }
+
+        for(std::size_t i = 0; i < n; ++i)
+            out[first + i] = (values[2][i] * mid_product + values[1][i]) * low_product
+                           + values[0][i];
+    }
+}
+
 }
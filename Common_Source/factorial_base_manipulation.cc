@@ -17,6 +17,8 @@
 // see <http://www.gnu.org/licenses/>.
 
 #include"../Common_Include/factorial_base_manipulation.h"
+#include"../Common_Include/instrumentation.h"
+#include<algorithm>
 #include<cassert>
 
 namespace factorial_base {
@@ -25,6 +27,8 @@ namespace factorial_base {
 // Returns the index of the last digit altered.
 unsigned increment(Number& inout) {
 
+    INSTRUMENT_COUNT(increments, 1);
+
     unsigned i = 0;
 
     for(auto& value : inout) {
@@ -40,6 +44,7 @@ unsigned increment(Number& inout) {
         }
 
         // Return the last altered digit.
+        INSTRUMENT_CARRY(i);
         return i;
     }
 
@@ -47,7 +52,118 @@ unsigned increment(Number& inout) {
     inout.push_back(1);
 
     // Return the last altered digit.
+    INSTRUMENT_CARRY(unsigned(inout.size()) - 1);
     return unsigned(inout.size()) - 1;
 }
 
+// Add the second argument to the first.
+void add(Number& inout, Number const& in) {
+
+    // Leading zeros of the addend must not lengthen the sum.
+    auto length = in.size();
+    while(length && !in[length - 1])
+        --length;
+
+    if(inout.size() < length)
+        inout.resize(length, 0U);
+
+    unsigned carry = 0;
+    std::size_t i = 0;
+
+    for(; i < length || (carry && i < inout.size()); ++i) {
+
+        auto sum = inout[i] + (i < length ? in[i] : 0U) + carry;
+        carry = sum > i + 1;
+        inout[i] = carry ? sum - unsigned(i + 2) : sum;
+    }
+
+    if(carry)
+        inout.push_back(1);
+}
+
+// Add the 64-bit second argument to the first.
+void add(Number& inout, std::uint64_t in) {
+
+    for(std::size_t i = 0; in; ++i) {
+
+        if(i == inout.size())
+            inout.push_back(0);
+
+        // Split the remaining value into this digit and those above it
+        // before adding, so the sum cannot overflow.
+        auto const radix = unsigned(i + 2);
+        auto digit = unsigned(in % radix) + inout[i];
+        in /= radix;
+
+        if(digit >= radix) {
+            digit -= radix;
+            ++in;
+        }
+
+        inout[i] = digit;
+    }
+}
+
+// Subtract the second argument from the first.
+void subtract(Number& inout, Number const& in) {
+
+    assert(compare(inout, in) >= 0);
+
+    unsigned borrow = 0;
+
+    for(std::size_t i = 0; i < inout.size() && (borrow || i < in.size()); ++i) {
+
+        auto const subtrahend = (i < in.size() ? in[i] : 0U) + borrow;
+        borrow = inout[i] < subtrahend;
+        inout[i] = inout[i] + (borrow ? unsigned(i + 2) : 0U) - subtrahend;
+    }
+
+    assert(!borrow);
+}
+
+// Compare two factorial base numbers.
+int compare(Number const& first, Number const& second) {
+
+    for(auto i = std::max(first.size(), second.size()); i--; ) {
+
+        auto const a = i < first.size() ? first[i] : 0U,
+                   b = i < second.size() ? second[i] : 0U;
+
+        if(a != b)
+            return a < b ? -1 : 1;
+    }
+
+    return 0;
+}
+
+// Divide the factorial base number, most significant digit first.  The
+// remainder carried down from digit i+1 is worth i+2 units of digit i.
+unsigned divide(Number& inout, unsigned divisor) {
+
+    assert(divisor);
+
+    std::uint64_t remainder = 0;
+
+    for(auto i = inout.size(); i--; ) {
+        auto const value = remainder * (i + 2) + inout[i];
+        inout[i] = unsigned(value / divisor);
+        remainder = value % divisor;
+    }
+
+    return unsigned(remainder);
+}
+
+// Compute the stride spreading count ranks evenly over all permutations.
+void spread(Number& out, std::size_t size, unsigned count) {
+
+    // size! is a single 1 digit above size-1 zeros.
+    out.assign(size ? size - 1 : 0, 0U);
+    out.push_back(1);
+
+    divide(out, count ? count : 1);
+
+    if(!compare(out, Number{}))
+        out.assign(1, 1U);
+}
+
 }
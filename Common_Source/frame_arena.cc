@@ -0,0 +1,111 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/frame_arena.h"
+#include"../Common_Include/instrumentation.h"
+#include<new>
+
+namespace frame_arena {
+
+namespace {
+
+// Alignment of every allocation; also the size of the frame prefix.
+std::size_t const alignment = alignof(std::max_align_t);
+
+inline std::size_t round_up(std::size_t bytes) {
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+thread_local arena* bound = nullptr;
+
+}
+
+arena::arena(std::size_t block_size)
+: block_size_(round_up(block_size)) {
+}
+
+// Carve the request from the current block, starting a new block when it does
+// not fit.  Requests larger than a block get a block of their own.
+void* arena::allocate(std::size_t bytes) {
+
+    bytes = round_up(bytes);
+
+    if(bytes > remaining_) {
+        auto const size = bytes > block_size_ ? bytes : block_size_;
+        blocks_.emplace_back(new char[size]);
+        next_      = blocks_.back().get();
+        remaining_ = size;
+
+        INSTRUMENT_COUNT(heap_allocations, 1);
+        INSTRUMENT_COUNT(heap_bytes, size);
+    }
+
+    void* result = next_;
+    next_      += bytes;
+    remaining_ -= bytes;
+
+    ++allocations_;
+    bytes_ += bytes;
+
+    return result;
+}
+
+arena* current() {
+    return bound;
+}
+
+scope::scope(arena& to_bind)
+: previous_(bound) {
+    bound = &to_bind;
+}
+
+scope::~scope() {
+    bound = previous_;
+}
+
+// Allocate a frame preceded by the address of its arena.
+void* allocate_frame(std::size_t bytes) {
+
+    INSTRUMENT_COUNT(frames, 1);
+    INSTRUMENT_COUNT(frame_bytes, bytes);
+
+    auto const total = alignment + bytes;
+    char* block;
+
+    if(bound)
+        block = static_cast<char*>(bound->allocate(total));
+    else {
+        block = static_cast<char*>(::operator new(total));
+        INSTRUMENT_COUNT(heap_allocations, 1);
+        INSTRUMENT_COUNT(heap_bytes, total);
+    }
+
+    *reinterpret_cast<arena**>(block) = bound;
+    return block + alignment;
+}
+
+// Return a heap frame to the heap.  Arena frames are freed with their arena.
+void deallocate_frame(void* frame) {
+
+    char* block = static_cast<char*>(frame) - alignment;
+
+    if(!*reinterpret_cast<arena**>(block))
+        ::operator delete(block);
+}
+
+}
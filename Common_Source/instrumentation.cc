@@ -0,0 +1,321 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/instrumentation.h"
+using std::string;
+#include<atomic>
+#include<map>
+#include<memory>
+#include<mutex>
+#include<sstream>
+#include<vector>
+#if defined(__linux__)
+#   include<linux/perf_event.h>
+#   include<sys/syscall.h>
+#   include<unistd.h>
+#   include<cstring>
+#endif
+
+namespace instrumentation {
+
+namespace {
+
+char const* const counter_names[counter_count] =
+{ "increments", "permutations", "resumes", "frames", "frame_bytes"
+, "heap_allocations", "heap_bytes" };
+
+// Accumulated measurements of one named stage.
+struct stage_totals {
+    std::uint64_t calls        { 0 },
+                  nanoseconds  { 0 },
+                  cycles       { 0 },
+                  cache_misses { 0 };
+};
+
+// The counts of one thread.  Each count is only written by its own thread, so
+// plain relaxed loads and stores suffice; the atomics only make concurrent
+// snapshots well defined.
+struct thread_record {
+    std::atomic<std::uint64_t>          counters[counter_count];
+    std::atomic<std::uint64_t>          carries[max_carry_depth + 1];
+    std::mutex                          stages_lock;
+    std::map<string, stage_totals>      stages;
+    int                                 cycles_fd       { -1 },
+                                        cache_misses_fd { -1 };
+    bool                                hardware_opened { false };
+
+    thread_record() {
+        for(auto& value : counters)
+            value.store(0, std::memory_order_relaxed);
+        for(auto& value : carries)
+            value.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Counts summed over threads.
+struct summary {
+    std::uint64_t                       threads { 0 },
+                                        counters[counter_count] = {},
+                                        carries[max_carry_depth + 1] = {};
+    std::map<string, stage_totals>      stages;
+
+    void add(thread_record& record) {
+
+        ++threads;
+        for(unsigned i = 0; i < counter_count; ++i)
+            counters[i] += record.counters[i].load(std::memory_order_relaxed);
+        for(unsigned i = 0; i <= max_carry_depth; ++i)
+            carries[i] += record.carries[i].load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> stages_guard(record.stages_lock);
+        for(auto const& stage : record.stages) {
+            auto& totals = stages[stage.first];
+            totals.calls        += stage.second.calls;
+            totals.nanoseconds  += stage.second.nanoseconds;
+            totals.cycles       += stage.second.cycles;
+            totals.cache_misses += stage.second.cache_misses;
+        }
+    }
+};
+
+// The records of the running threads, and the counts of those that have
+// exited, folded together so neither grows with the threads started.
+struct registry {
+    std::mutex                                  lock;
+    std::vector<std::unique_ptr<thread_record>> records;
+    summary                                     retired;
+};
+
+registry& get_registry() {
+    static registry instance;
+    return instance;
+}
+
+std::atomic<bool> hardware_enabled { false };
+
+void close_hardware(thread_record& record);
+
+// Owns the calling thread's record, retiring it when the thread exits.
+struct local_owner {
+    thread_record* record { nullptr };
+
+    ~local_owner() {
+        if(!record)
+            return;
+
+        close_hardware(*record);
+
+        auto& all = get_registry();
+        std::lock_guard<std::mutex> guard(all.lock);
+        all.retired.add(*record);
+        for(auto i = all.records.begin(); i != all.records.end(); ++i)
+            if(i->get() == record) {
+                all.records.erase(i);
+                break;
+            }
+    }
+};
+
+thread_record& local_record() {
+
+    // The registry is made first so that it outlives the owner.
+    auto& all = get_registry();
+    thread_local local_owner owner;
+
+    if(!owner.record) {
+        std::lock_guard<std::mutex> guard(all.lock);
+        all.records.emplace_back(new thread_record);
+        owner.record = all.records.back().get();
+    }
+
+    return *owner.record;
+}
+
+inline void add(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+    value.store( value.load(std::memory_order_relaxed) + amount
+               , std::memory_order_relaxed);
+}
+
+#if defined(__linux__)
+
+// Open a per thread hardware counter, returning -1 on failure.
+int open_counter(std::uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof attr);
+    attr.size           = sizeof attr;
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::uint64_t read_counter(int fd) {
+    std::uint64_t value = 0;
+    if(fd < 0 || ::read(fd, &value, sizeof value) != ssize_t(sizeof value))
+        return 0;
+    return value;
+}
+
+// Open the calling thread's hardware counters once requested.
+void open_hardware(thread_record& record) {
+    if(record.hardware_opened || !hardware_enabled.load())
+        return;
+    record.cycles_fd       = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+    record.cache_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+    record.hardware_opened = true;
+}
+
+void close_hardware(thread_record& record) {
+    if(record.cycles_fd >= 0)
+        ::close(record.cycles_fd);
+    if(record.cache_misses_fd >= 0)
+        ::close(record.cache_misses_fd);
+    record.cycles_fd = record.cache_misses_fd = -1;
+}
+
+#else
+
+std::uint64_t read_counter(int) { return 0; }
+void open_hardware(thread_record&) { }
+void close_hardware(thread_record&) { }
+
+#endif
+
+// Write the string as a JSON string literal.
+void write_json_string(std::ostream& out, string const& value) {
+    out << '"';
+    for(auto ch : value) {
+        if(ch == '"' || ch == '\\')
+            out << '\\';
+        out << ch;
+    }
+    out << '"';
+}
+
+}
+
+// Add to one of the calling thread's counts.
+void count(counter_id id, std::uint64_t amount) {
+    add(local_record().counters[id], amount);
+}
+
+// Record the depth of a carry.
+void carry(unsigned depth) {
+    add( local_record().carries[depth < max_carry_depth ? depth : max_carry_depth]
+       , 1);
+}
+
+// Request hardware counts for stages started afterwards.
+bool enable_hardware_counters() {
+#if defined(__linux__)
+    int const probe = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+    if(probe < 0)
+        return false;
+    ::close(probe);
+    hardware_enabled.store(true);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Start timing a stage.
+stage_timer::stage_timer(string name)
+: name_(std::move(name)) {
+    auto& record = local_record();
+    open_hardware(record);
+    cycles_       = read_counter(record.cycles_fd);
+    cache_misses_ = read_counter(record.cache_misses_fd);
+    start_        = std::chrono::steady_clock::now();
+}
+
+// Stop timing a stage and accumulate its measurements.
+stage_timer::~stage_timer() {
+
+    auto const elapsed = std::chrono::steady_clock::now() - start_;
+    auto& record = local_record();
+    auto const cycles       = read_counter(record.cycles_fd) - cycles_,
+               cache_misses = read_counter(record.cache_misses_fd) - cache_misses_;
+
+    std::lock_guard<std::mutex> guard(record.stages_lock);
+    auto& totals = record.stages[name_];
+    ++totals.calls;
+    totals.nanoseconds  += std::uint64_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    totals.cycles       += cycles;
+    totals.cache_misses += cache_misses;
+}
+
+// Sum the counts of all threads into a JSON object.
+string snapshot_json() {
+
+    auto& all = get_registry();
+    std::unique_lock<std::mutex> guard(all.lock);
+
+    auto total = all.retired;
+    for(auto const& record : all.records)
+        total.add(*record);
+
+    guard.unlock();
+
+    std::ostringstream out;
+    out << "{\"threads\":" << total.threads << ",\"counters\":{";
+    for(unsigned i = 0; i < counter_count; ++i)
+        out << (i ? "," : "") << '"' << counter_names[i] << "\":"
+            << total.counters[i];
+
+    out << "},\"carry_depth\":[";
+    for(unsigned i = 0; i <= max_carry_depth; ++i)
+        out << (i ? "," : "") << total.carries[i];
+
+    out << "],\"stages\":{";
+    bool first = true;
+    for(auto const& stage : total.stages) {
+        out << (first ? "" : ",");
+        first = false;
+        write_json_string(out, stage.first);
+        out << ":{\"calls\":"         << stage.second.calls
+            << ",\"nanoseconds\":"    << stage.second.nanoseconds
+            << ",\"cycles\":"         << stage.second.cycles
+            << ",\"cache_misses\":"   << stage.second.cache_misses << '}';
+    }
+    out << "}}";
+
+    return out.str();
+}
+
+// Zero the counts of all threads.
+void reset() {
+
+    auto& all = get_registry();
+    std::lock_guard<std::mutex> guard(all.lock);
+
+    all.retired = summary();
+
+    for(auto const& record : all.records) {
+        for(auto& value : record->counters)
+            value.store(0, std::memory_order_relaxed);
+        for(auto& value : record->carries)
+            value.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> stages_guard(record->stages_lock);
+        record->stages.clear();
+    }
+}
+
+}
@@ -0,0 +1,147 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/mapped_file.h"
+#if defined(_WIN32)
+#   define NOMINMAX
+#   include<windows.h>
+#else
+#   include<sys/mman.h>
+#   include<sys/stat.h>
+#   include<fcntl.h>
+#   include<unistd.h>
+#endif
+
+// Map an existing file for reading.
+mapped_file::mapped_file(std::string const& path) {
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ
+                             , nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL
+                             , nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return;
+    file_ = file;
+
+    LARGE_INTEGER file_size;
+    if(GetFileSizeEx(file, &file_size))
+        map(std::size_t(file_size.QuadPart));
+#else
+    file_ = ::open(path.c_str(), O_RDONLY);
+    if(file_ < 0)
+        return;
+
+    struct stat file_status;
+    if(!::fstat(file_, &file_status))
+        map(std::size_t(file_status.st_size));
+#endif
+}
+
+// Create or truncate a file of the given size and map it for writing.
+mapped_file::mapped_file(std::string const& path, std::uint64_t bytes)
+: writable_(true) {
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ | GENERIC_WRITE, 0
+                             , nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL
+                             , nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return;
+    file_ = file;
+
+    LARGE_INTEGER file_size;
+    file_size.QuadPart = LONGLONG(bytes);
+    if(SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) && SetEndOfFile(file))
+        map(std::size_t(bytes));
+#else
+    file_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(file_ < 0)
+        return;
+
+    if(!::ftruncate(file_, off_t(bytes)))
+        map(std::size_t(bytes));
+#endif
+}
+
+// Map size bytes of the open file.  Empty files are not mapped.
+void mapped_file::map(std::size_t bytes) {
+
+    if(!bytes)
+        return;
+
+#if defined(_WIN32)
+    mapping_ = CreateFileMappingA( file_, nullptr
+                                 , writable_ ? PAGE_READWRITE : PAGE_READONLY
+                                 , 0, 0, nullptr);
+    if(!mapping_)
+        return;
+
+    data_ = static_cast<std::uint8_t*>(
+                MapViewOfFile( mapping_
+                             , writable_ ? FILE_MAP_WRITE : FILE_MAP_READ
+                             , 0, 0, 0));
+#else
+    void* mapping = ::mmap( nullptr, bytes
+                          , writable_ ? PROT_READ | PROT_WRITE : PROT_READ
+                          , writable_ ? MAP_SHARED : MAP_PRIVATE, file_, 0);
+    if(mapping != MAP_FAILED)
+        data_ = static_cast<std::uint8_t*>(mapping);
+#endif
+
+    if(data_)
+        bytes_ = bytes;
+}
+
+// Release the mapping and the file.
+mapped_file::~mapped_file() {
+#if defined(_WIN32)
+    if(data_)
+        UnmapViewOfFile(data_);
+    if(mapping_)
+        CloseHandle(mapping_);
+    if(file_)
+        CloseHandle(file_);
+#else
+    if(data_)
+        ::munmap(data_, bytes_);
+    if(file_ >= 0)
+        ::close(file_);
+#endif
+}
+
+// Request huge pages for the mapping.
+bool mapped_file::advise_huge_pages() {
+#if defined(MADV_HUGEPAGE)
+    return data_ && !::madvise(data_, bytes_, MADV_HUGEPAGE);
+#else
+    return false;
+#endif
+}
+
+// Write modified pages back to the file.
+bool mapped_file::flush() {
+
+    if(!data_ || !writable_)
+        return false;
+
+#if defined(_WIN32)
+    return FlushViewOfFile(data_, 0) && FlushFileBuffers(file_);
+#else
+    return !::msync(data_, bytes_, MS_SYNC);
+#endif
+}
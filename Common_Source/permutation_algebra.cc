@@ -0,0 +1,85 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/permutation_algebra.h"
+
+namespace permutation_algebra {
+
+void compose( Index* out, Index const* first, Index const* second
+            , std::size_t n, unsigned threads) {
+    apply(out, first, second, n, threads);
+}
+
+// A scatter, split over threads by source range.  Each position is written
+// once, as p is a permutation.
+void invert(Index* out, Index const* p, std::size_t n, unsigned threads) {
+
+    assert(!n || out != p);
+
+    factorial_base::parallel_for(n, [=](std::size_t first, std::size_t last) {
+                                        for(auto i = first; i < last; ++i)
+                                            out[p[i]] = Index(i);
+                                    }
+                                , n < parallel_size ? 1 : threads);
+}
+
+std::size_t cycles( std::vector<Index>&       elements
+                  , std::vector<std::size_t>& starts
+                  , Index const*              p
+                  , std::size_t               n) {
+
+    elements.clear();
+    elements.reserve(n);
+    starts.clear();
+
+    std::vector<std::uint64_t> done((n + 63) / 64, 0);
+
+    for(std::size_t start = 0; start < n; ++start) {
+
+        if(done[start / 64] >> (start % 64) & 1)
+            continue;
+
+        starts.push_back(elements.size());
+
+        for(auto i = start; !(done[i / 64] >> (i % 64) & 1); i = p[i]) {
+            done[i / 64] |= std::uint64_t(1) << (i % 64);
+            elements.push_back(Index(i));
+        }
+    }
+
+    auto const count = starts.size();
+    starts.push_back(n);
+    return count;
+}
+
+bool is_permutation(Index const* p, std::size_t n) {
+
+    std::vector<std::uint64_t> seen((n + 63) / 64, 0);
+
+    for(std::size_t i = 0; i < n; ++i) {
+
+        if(p[i] >= n || seen[p[i] / 64] >> (p[i] % 64) & 1)
+            return false;
+
+        seen[p[i] / 64] |= std::uint64_t(1) << (p[i] % 64);
+    }
+
+    return true;
+}
+
+}
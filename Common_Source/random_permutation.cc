@@ -0,0 +1,224 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/random_permutation.h"
+#include"../Common_Include/small_permutation.h"
+#include"../Common_Include/parallel_for.h"
+#include<algorithm>
+#include<cstring>
+#include<cassert>
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include<intrin.h>
+#endif
+
+namespace random_permutation {
+
+namespace {
+
+inline std::uint64_t rotate(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Return the low half of the 128-bit product, storing the high half.
+inline std::uint64_t multiply( std::uint64_t  a
+                             , std::uint64_t  b
+                             , std::uint64_t& high) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &high);
+#elif defined(__SIZEOF_INT128__)
+    auto const product = (unsigned __int128)a * b;
+    high = std::uint64_t(product >> 64);
+    return std::uint64_t(product);
+#else
+    std::uint64_t const a_lo = a & 0xFFFFFFFF, a_hi = a >> 32,
+                        b_lo = b & 0xFFFFFFFF, b_hi = b >> 32,
+                        lo_lo = a_lo * b_lo,
+                        hi_lo = a_hi * b_lo,
+                        lo_hi = a_lo * b_hi,
+                        cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    high = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+// Expand the seed into generator state.
+inline std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+engine::engine(std::uint64_t seed, std::uint64_t stream) {
+    for(auto& word : state_)
+        word = splitmix64(seed);
+    while(stream--)
+        jump();
+}
+
+engine::result_type engine::operator()() {
+
+    auto const result = rotate(state_[1] * 5, 7) * 9,
+               shifted = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= shifted;
+    state_[3] = rotate(state_[3], 45);
+
+    return result;
+}
+
+// Apply the published jump polynomial.
+void engine::jump() {
+
+    static std::uint64_t const polynomial[] = { 0x180EC6D33CFD0ABAULL
+                                              , 0xD5A61266F0C9392CULL
+                                              , 0xA9582618E03FC9AAULL
+                                              , 0x39ABDC4529B1661CULL };
+
+    std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+    for(auto word : polynomial)
+        for(int bit = 0; bit < 64; ++bit) {
+            if(word >> bit & 1)
+                for(int i = 0; i < 4; ++i)
+                    jumped[i] ^= state_[i];
+            (*this)();
+        }
+
+    std::copy(jumped, jumped + 4, state_);
+}
+
+sampler::sampler(std::size_t size, std::uint64_t seed, std::uint64_t stream)
+: size_(size)
+, random_(seed, stream)
+, state_(size ? size - 1 : 0, 0U) {
+
+    assert(size <= max_size);
+
+    // Pack as many digits into each group as their radices' product allows.
+    for(unsigned i = 0; i < state_.size(); ) {
+
+        group g { i, i, 1, 0 };
+
+        for(; g.last < state_.size(); ++g.last) {
+            std::uint64_t const radix = g.last + 2;
+            if(g.product > ~std::uint64_t(0) / radix)
+                break;
+            g.product *= radix;
+        }
+
+        g.threshold = (0 - g.product) % g.product;
+        groups_.push_back(g);
+        i = g.last;
+    }
+}
+
+// Draw a uniformly distributed permutation state.
+factorial_base::Number const& sampler::draw() {
+
+    for(auto const& g : groups_) {
+
+        std::uint64_t fraction;
+
+        do {
+            fraction = random_();
+            for(auto i = g.first; i < g.last; ++i) {
+                std::uint64_t digit;
+                fraction = multiply(fraction, i + 2, digit);
+                state_[i] = unsigned(digit);
+            }
+        } while(fraction < g.threshold);
+    }
+
+    return state_;
+}
+
+// Select the most significant digit's index first, erasing it from those
+// remaining, as lexicographic unranking does.
+void sampler::unrank(unsigned char* out) const {
+
+    if(size_ <= small_permutation::max_size) {
+        small_permutation::Shuffle shuffle;
+        small_permutation::unrank_lexicographic(shuffle, state_);
+        std::memcpy(out, shuffle.index, size_);
+        return;
+    }
+
+    for(std::size_t i = 0; i < size_; ++i)
+        out[i] = (unsigned char)i;
+
+    small_permutation::unrank_lexicographic(out, out, state_.data(), size_);
+}
+
+void sampler::sample(unsigned char* out) {
+    draw();
+    unrank(out);
+}
+
+void sampler::sample(unsigned char* rows, std::size_t count) {
+    for(; count--; rows += size_)
+        sample(rows);
+}
+
+void sampler::sample(std::string& out, std::string const& in) {
+
+    assert(in.size() == size_);
+
+    unsigned char indices[max_size];
+    sample(indices);
+
+    out.resize(size_);
+    for(std::size_t i = 0; i < size_; ++i)
+        out[i] = in[indices[i]];
+}
+
+// Draw rows across threads, a stream per block of rows.
+void sample_batch( std::size_t    size
+                 , std::uint64_t  seed
+                 , unsigned char* rows
+                 , std::size_t    count
+                 , unsigned       threads) {
+
+    auto const blocks = (count + batch_stream_rows - 1) / batch_stream_rows;
+
+    factorial_base::parallel_for(blocks,
+        [=](std::size_t first, std::size_t last) {
+
+            engine  stream(seed, first);
+            sampler drawn(size, seed);
+
+            for(auto block = first; block < last; ++block) {
+
+                drawn.random() = stream;
+                stream.jump();
+
+                auto const begin = block * batch_stream_rows,
+                           end   = std::min(count, begin + batch_stream_rows);
+
+                drawn.sample(rows + begin * size, end - begin);
+            }
+        }, threads);
+}
+
+}
@@ -0,0 +1,199 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of the Factorial Base Component.
+//
+// The Factorial Base Component is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// The Factorial Base Component is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with The Factorial Base Component.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"../Common_Include/small_permutation.h"
+using factorial_base::Number;
+#include<cstring>
+#include<cassert>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define SMALL_PERMUTATION_X86 1
+#   include<tmmintrin.h>
+#   if defined(_MSC_VER)
+#       include<intrin.h>
+#       define SMALL_PERMUTATION_SSSE3
+#   else
+#       define SMALL_PERMUTATION_SSSE3 __attribute__((target("ssse3")))
+#   endif
+#endif
+
+namespace small_permutation {
+
+namespace {
+
+// Portable implementations.
+
+void unrank_scalar(Shuffle& out, Number const& state) {
+
+    // Positions past the permutation hold themselves.
+    Shuffle chars;
+    identity(chars);
+    identity(out);
+
+    unrank_lexicographic(out.index, chars.index, state.data(), state.size() + 1);
+}
+
+void compose_scalar(Shuffle& out, Shuffle const& first, Shuffle const& second) {
+    Shuffle result;
+    for(unsigned i = 0; i < max_size; ++i)
+        result.index[i] = first.index[second.index[i]];
+    out = result;
+}
+
+void apply_scalar(char* out, char const* in, Shuffle const& p, std::size_t size) {
+    char work[max_size];
+    std::memcpy(work, in, size);
+    for(std::size_t i = 0; i < size; ++i)
+        out[i] = work[p.index[i]];
+}
+
+#if defined(SMALL_PERMUTATION_X86)
+
+// SSSE3 implementations.  Each permutation step is one pshufb.
+
+SMALL_PERMUTATION_SSSE3
+inline __m128i identity_register() {
+    return _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+// Move the character selected by digit from chars into the given position
+// of result, erasing it from chars by shifting the lanes above it down.
+SMALL_PERMUTATION_SSSE3
+inline void unrank_step( __m128i& result, __m128i& chars
+                       , unsigned position, unsigned digit) {
+
+    __m128i const ident = identity_register();
+
+    // Broadcast the selected character and blend it into its lane.
+    __m128i const pick = _mm_shuffle_epi8(chars, _mm_set1_epi8(char(digit)));
+    __m128i const lane = _mm_cmpeq_epi8(ident, _mm_set1_epi8(char(position)));
+    result = _mm_or_si128( _mm_andnot_si128(lane, result)
+                         , _mm_and_si128(lane, pick));
+
+    __m128i const above = _mm_cmpgt_epi8(ident, _mm_set1_epi8(char(digit) - 1));
+    chars = _mm_shuffle_epi8(chars, _mm_sub_epi8(ident, above));
+}
+
+SMALL_PERMUTATION_SSSE3
+void unrank_ssse3(Shuffle& out, Number const& state) {
+
+    __m128i chars  = identity_register(),
+            result = chars;
+
+    unsigned position = 0;
+
+    // Digits are taken most significant first.  The final position takes the
+    // single remaining character, i.e. an implicit digit of 0.
+    for(auto digit = state.rbegin(); digit != state.rend(); ++digit)
+        unrank_step(result, chars, position++, *digit);
+    unrank_step(result, chars, position, 0);
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(out.index), result);
+}
+
+SMALL_PERMUTATION_SSSE3
+void compose_ssse3(Shuffle& out, Shuffle const& first, Shuffle const& second) {
+    __m128i const a = _mm_load_si128(reinterpret_cast<__m128i const*>(first.index)),
+                  b = _mm_load_si128(reinterpret_cast<__m128i const*>(second.index));
+    _mm_store_si128( reinterpret_cast<__m128i*>(out.index)
+                   , _mm_shuffle_epi8(a, b));
+}
+
+SMALL_PERMUTATION_SSSE3
+void apply_ssse3(char* out, char const* in, Shuffle const& p, std::size_t size) {
+    alignas(16) char work[max_size];
+    std::memcpy(work, in, size);
+    __m128i const data = _mm_load_si128(reinterpret_cast<__m128i const*>(work)),
+                  mask = _mm_load_si128(reinterpret_cast<__m128i const*>(p.index));
+    _mm_store_si128( reinterpret_cast<__m128i*>(work)
+                   , _mm_shuffle_epi8(data, mask));
+    std::memcpy(out, work, size);
+}
+
+// Test the CPU for SSSE3 support.
+bool detect_ssse3() {
+#   if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#   else
+    return __builtin_cpu_supports("ssse3");
+#   endif
+}
+
+#else
+
+bool detect_ssse3() { return false; }
+
+#endif
+
+// The set of implementations in use, selected once on first use.
+struct kernels {
+    bool accelerated;
+    void (*unrank)(Shuffle&, Number const&);
+    void (*compose)(Shuffle&, Shuffle const&, Shuffle const&);
+    void (*apply)(char*, char const*, Shuffle const&, std::size_t);
+};
+
+kernels const& select_kernels() {
+#   if defined(SMALL_PERMUTATION_X86)
+    static kernels const selected = detect_ssse3()
+        ? kernels{ true, unrank_ssse3, compose_ssse3, apply_ssse3 }
+        : kernels{ false, unrank_scalar, compose_scalar, apply_scalar };
+#   else
+    static kernels const selected =
+        kernels{ false, unrank_scalar, compose_scalar, apply_scalar };
+#   endif
+    return selected;
+}
+
+}
+
+bool accelerated() {
+    return select_kernels().accelerated;
+}
+
+void identity(Shuffle& out) {
+    for(unsigned i = 0; i < max_size; ++i)
+        out.index[i] = std::uint8_t(i);
+}
+
+void unrank_lexicographic(Shuffle& out, Number const& state) {
+    assert(state.size() < max_size);
+    select_kernels().unrank(out, state);
+}
+
+void compose(Shuffle& out, Shuffle const& first, Shuffle const& second) {
+    select_kernels().compose(out, first, second);
+}
+
+// There is no single instruction scatter, so inversion is scalar on all
+// targets.
+void invert(Shuffle& out, Shuffle const& in) {
+    Shuffle result;
+    for(unsigned i = 0; i < max_size; ++i)
+        result.index[in.index[i]] = std::uint8_t(i);
+    out = result;
+}
+
+void apply(char* out, char const* in, Shuffle const& p, std::size_t size) {
+    assert(size <= max_size);
+    select_kernels().apply(out, in, p, size);
+}
+
+}
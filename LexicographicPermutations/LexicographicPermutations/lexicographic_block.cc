@@ -0,0 +1,202 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"lexicographic_block.h"
+#include"lexicographic_table.h"
+#include"../../Common_Include/factorial_base_manipulation.h"
+#include"../../Common_Include/factorial_base_conversions.h"
+#include"../../Common_Include/small_permutation.h"
+using factorial_base::Number;
+#include<algorithm>
+#include<cstring>
+#include<cassert>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define LEXICOGRAPHIC_BLOCK_X86 1
+#   include<tmmintrin.h>
+#   if defined(_MSC_VER)
+#       include<intrin.h>
+#       define LEXICOGRAPHIC_BLOCK_SSSE3
+#   else
+#       define LEXICOGRAPHIC_BLOCK_SSSE3 __attribute__((target("ssse3")))
+#   endif
+#endif
+
+namespace lexicographic_block {
+
+namespace {
+
+static_assert( factorial_base::factorial(tail) == block_size
+             , "a block holds every ordering of the tail");
+
+// The orderings of the tail in lexicographic order.
+constexpr lexicographic_table<tail> orderings = make_lexicographic_table<tail>();
+
+// Portable implementation.  Write the block of permutations whose first
+// is given, copying the fixed positions and gathering the tail.
+void fill_scalar(char* out, char const* first, std::size_t size) {
+
+    auto const fixed = size - tail;
+
+    for(std::size_t rank = 0; rank < block_size; ++rank, out += size) {
+        std::memcpy(out, first, fixed);
+        for(std::size_t i = 0; i < tail; ++i)
+            out[fixed + i] = first[fixed + orderings.permutations[rank][i]];
+    }
+}
+
+#if defined(LEXICOGRAPHIC_BLOCK_X86)
+
+// SSSE3 implementation.  A window of the last 16 positions, or all of them
+// for shorter permutations, is shuffled into each ordering by one pshufb.
+
+// The window's shuffles, by the lane of the window at which the tail starts.
+struct shuffles {
+    alignas(16) std::uint8_t lanes[block_size][16];
+};
+
+std::size_t const window = 16,
+                  first_tail_lane = min_size - tail,
+                  tail_lanes = window - tail - first_tail_lane + 1;
+
+shuffles const* build_shuffles() {
+
+    static shuffles table[tail_lanes];
+
+    for(std::size_t t = 0; t < tail_lanes; ++t)
+        for(std::size_t rank = 0; rank < block_size; ++rank) {
+            auto& lanes = table[t].lanes[rank];
+            auto const start = first_tail_lane + t;
+            for(std::size_t i = 0; i < window; ++i)
+                lanes[i] = std::uint8_t(i);
+            for(std::size_t i = 0; i < tail; ++i)
+                lanes[start + i] = std::uint8_t(start + orderings.permutations[rank][i]);
+        }
+
+    return table;
+}
+
+LEXICOGRAPHIC_BLOCK_SSSE3
+void fill_ssse3(char* out, char const* first, std::size_t size) {
+
+    static shuffles const* const table = build_shuffles();
+
+    // Positions before the window are fixed for the block.
+    auto const head  = size > window ? size - window : 0,
+               start = size - tail - head;
+    auto const& lanes = table[start - first_tail_lane].lanes;
+
+    alignas(16) char padded[window] = {};
+    std::memcpy(padded, first + head, size - head);
+    __m128i const data = _mm_load_si128(reinterpret_cast<__m128i const*>(padded));
+
+    // Shorter permutations' stores run into the next one's, which overwrites
+    // them, so the last is stored through the padding.
+    auto const direct = size >= window ? block_size : block_size - 1;
+
+    for(std::size_t rank = 0; rank < direct; ++rank, out += size) {
+        std::memcpy(out, first, head);
+        __m128i const mask = _mm_load_si128(reinterpret_cast<__m128i const*>(lanes[rank]));
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(out + head)
+                        , _mm_shuffle_epi8(data, mask));
+    }
+
+    if(direct < block_size) {
+        __m128i const mask = _mm_load_si128(reinterpret_cast<__m128i const*>(lanes[direct]));
+        _mm_store_si128( reinterpret_cast<__m128i*>(padded)
+                       , _mm_shuffle_epi8(data, mask));
+        std::memcpy(out, padded, size);
+    }
+}
+
+// Test the CPU for SSSE3 support.
+bool detect_ssse3() {
+#   if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#   else
+    return __builtin_cpu_supports("ssse3");
+#   endif
+}
+
+#endif
+
+// The block writer in use, selected once on first use.
+using fill_function = void (*)(char*, char const*, std::size_t);
+
+fill_function select_fill() {
+#   if defined(LEXICOGRAPHIC_BLOCK_X86)
+    static fill_function const selected = detect_ssse3() ? fill_ssse3 : fill_scalar;
+#   else
+    static fill_function const selected = fill_scalar;
+#   endif
+    return selected;
+}
+
+}
+
+// Write the count permutations from rank first on.
+void write( char*          out
+          , char const*    in
+          , std::size_t    size
+          , std::uint64_t  first
+          , std::uint64_t  count) {
+
+    assert(size >= min_size && size <= max_size);
+
+    if(!count)
+        return;
+
+    auto const fill = select_fill();
+
+    // The state of the first block's first permutation and the permutations
+    // of the block before first.
+    Number state;
+    factorial_base::to_factorial_base64(state, first - first % block_size, size - 1);
+    auto skip = std::size_t(first % block_size);
+
+    char leader[max_size],
+         partial[block_size * max_size];
+
+    for(;;) {
+
+        small_permutation::unrank_lexicographic(leader, in, state.data(), size);
+
+        if(!skip && count >= block_size) {
+            fill(out, leader, size);
+            out   += block_size * size;
+            count -= block_size;
+        } else {
+            // A block begun or ended part way is written aside first.
+            auto const taken = std::size_t(std::min<std::uint64_t>(block_size - skip, count));
+            fill(partial, leader, size);
+            std::memcpy(out, partial + skip * size, taken * size);
+            out   += taken * size;
+            count -= taken;
+            skip   = 0;
+        }
+
+        if(!count)
+            break;
+
+        factorial_base::add(state, block_size);
+    }
+}
+
+}
@@ -0,0 +1,51 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<cstddef>
+#include<cstdint>
+
+// Writes runs of lexicographic permutations a block at a time.  Within each
+// block of tail! consecutive ranks starting at a multiple of tail!, the first
+// size - tail positions are fixed and the last tail positions take each of
+// their orderings in turn.  The fixed positions and the permutation state are
+// therefore computed once per block, and each permutation of the block is
+// copied from the block's first through a precomputed table of tail
+// orderings, one byte shuffle and store where SSSE3 is available.
+namespace lexicographic_block {
+
+// The positions permuted from the table and the permutations per block.
+std::size_t const tail       = 5;
+std::size_t const block_size = 120;
+
+// The shortest permutation written in blocks, below which the run of each
+// prefix is too short to pay for the table, and the longest, whose ranks
+// fit in 64 bits.
+std::size_t const min_size = 10;
+std::size_t const max_size = 20;
+
+// Write the count permutations of the size bytes of in from rank first on
+// (in itself having rank 0) to out, size bytes each.  With the identity for
+// in, the index lists are written.  size is from min_size to max_size.
+void write( char*          out
+          , char const*    in
+          , std::size_t    size
+          , std::uint64_t  first
+          , std::uint64_t  count);
+
+}
@@ -0,0 +1,240 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"lexicographic_dump.h"
+#include"lexicographic_engine.h"
+#include"lexicographic_block.h"
+#include"../../Common_Include/factorial_base_conversions.h"
+#include"../../Common_Include/small_permutation.h"
+#include"../../Common_Include/parallel_for.h"
+#include"../../Common_Include/little_endian.h"
+using factorial_base::Number;
+using std::string;
+#include<algorithm>
+#include<cstring>
+#include<utility>
+
+namespace lexicographic_dump {
+
+namespace {
+
+using little_endian::put;
+using little_endian::get;
+
+void put_header(std::uint8_t* out, header const& h) {
+    put(out, h.magic, 4);
+    put(out + 4, h.version, 2);
+    put(out + 6, h.size, 2);
+    put(out + 8, h.flags, 2);
+    put(out + 10, h.reserved, 2);
+    put(out + 12, h.stride, 4);
+    put(out + 16, h.first, 8);
+    put(out + 24, h.count, 8);
+    put(out + 32, h.data_offset, 8);
+}
+
+header get_header(std::uint8_t const* in) {
+    header h;
+    h.magic       = std::uint32_t(get(in, 4));
+    h.version     = std::uint16_t(get(in + 4, 2));
+    h.size        = std::uint16_t(get(in + 6, 2));
+    h.flags       = std::uint16_t(get(in + 8, 2));
+    h.reserved    = std::uint16_t(get(in + 10, 2));
+    h.stride      = std::uint32_t(get(in + 12, 4));
+    h.first       = get(in + 16, 8);
+    h.count       = get(in + 24, 8);
+    h.data_offset = get(in + 32, 8);
+    return h;
+}
+
+// The index list of a lexicographic permutation state, selecting the most
+// significant digit's index first and erasing it from those remaining.
+void unrank(unsigned char* out, Number const& state, std::size_t size) {
+
+    if(size <= small_permutation::max_size) {
+        small_permutation::Shuffle shuffle;
+        small_permutation::unrank_lexicographic(shuffle, state);
+        std::memcpy(out, shuffle.index, size);
+        return;
+    }
+
+    for(std::size_t i = 0; i < size; ++i)
+        out[i] = (unsigned char)i;
+
+    small_permutation::unrank_lexicographic(out, out, state.data(), size);
+}
+
+// Store an index list as a record.
+inline void store( std::uint8_t* record, unsigned char const* indices
+                 , std::size_t size, bool pack) {
+
+    if(!pack) {
+        std::memcpy(record, indices, size);
+        return;
+    }
+
+    for(std::size_t i = 0; i < size; i += 2)
+        record[i / 2] = std::uint8_t(indices[i]
+                                     | (i + 1 < size ? indices[i + 1] << 4 : 0));
+}
+
+}
+
+// Write the count permutations of size elements from rank first on.
+bool write( string const&   path
+          , std::size_t     size
+          , std::uint64_t   first
+          , std::uint64_t   count
+          , options const&  settings) {
+
+    if(!size || size > max_size || (settings.pack && size > 16))
+        return false;
+
+    auto const total = std::uint64_t(factorial_base::factorial(size));
+    if(first > total || count > total - first)
+        return false;
+
+    header h{ magic, version, std::uint16_t(size)
+            , std::uint16_t((settings.pack ? packed : 0)
+                            | (settings.huge_pages ? huge_page_aligned : 0))
+            , 0
+            , std::uint32_t(settings.pack ? (size + 1) / 2 : size)
+            , first, count
+            , settings.huge_pages ? huge_page_bytes : header_bytes };
+
+    mapped_file out(path, h.data_offset + count * h.stride);
+    if(!out.is_open())
+        return false;
+
+    auto const base = out.writable_data();
+    put_header(base, h);
+
+    if(settings.huge_pages)
+        out.advise_huge_pages();
+
+    auto const records = base + h.data_offset;
+
+    factorial_base::parallel_for(std::size_t(count),
+        [&](std::size_t begin, std::size_t end) {
+
+            if(begin == end)
+                return;
+
+            // Whole byte records of long permutations are written in blocks
+            // sharing their leading positions.
+            if(!settings.pack && size >= lexicographic_block::min_size) {
+
+                char identity[max_size];
+                for(std::size_t i = 0; i < size; ++i)
+                    identity[i] = char(i);
+
+                lexicographic_block::write( reinterpret_cast<char*>(records + begin * h.stride)
+                                          , identity, size, first + begin, end - begin);
+                return;
+            }
+
+            // Seek to the shard's first rank.
+            Number state;
+            unsigned char indices[max_size];
+
+            factorial_base::to_factorial_base64(state, first + begin, size - 1);
+            unrank(indices, state, size);
+
+            auto record = records + begin * h.stride;
+            store(record, indices, size, settings.pack);
+
+            for(auto i = begin + 1; i < end; ++i) {
+
+                lexicographic_step( state, size
+                                  , [&indices](std::size_t a, std::size_t b) {
+                                        std::swap(indices[a], indices[b]);
+                                    }
+                                  , [&indices](std::size_t a, std::size_t b) {
+                                        std::reverse(indices + a, indices + b);
+                                    });
+
+                record += h.stride;
+                store(record, indices, size, settings.pack);
+            }
+        }, settings.threads);
+
+    return out.flush();
+}
+
+// Write all size! permutations.
+bool write(string const& path, std::size_t size, options const& settings) {
+    return size <= max_size
+        && write( path, size, 0
+                , std::uint64_t(factorial_base::factorial(size)), settings);
+}
+
+// Map the file and validate its header.
+reader::reader(string const& path)
+: file_(path) {
+
+    if(file_.size() < header_bytes)
+        return;
+
+    header_ = get_header(file_.data());
+
+    auto const pack = (header_.flags & packed) != 0;
+
+    bool const valid = header_.magic == magic
+                    && header_.version == version
+                    && header_.size && header_.size <= max_size
+                    && header_.stride == (pack ? (header_.size + 1U) / 2
+                                               : header_.size)
+                    && header_.data_offset >= header_bytes
+                    && header_.data_offset <= file_.size()
+                    && header_.count
+                       <= (file_.size() - header_.data_offset) / header_.stride;
+
+    if(valid)
+        data_ = file_.data() + header_.data_offset;
+}
+
+// Copy the index list of the rank into out.
+void reader::permutation(unsigned char* out, std::uint64_t rank) const {
+
+    auto const in = record(rank);
+
+    if(!(header_.flags & packed)) {
+        std::memcpy(out, in, header_.size);
+        return;
+    }
+
+    for(std::size_t i = 0; i < header_.size; ++i)
+        out[i] = (in[i / 2] >> (i & 1) * 4) & 0x0F;
+}
+
+// Permute the string provided as the rank dictates.
+void reader::permutation( string&        out
+                        , string const&  in
+                        , std::uint64_t  rank) const {
+
+    assert(in.size() == header_.size);
+
+    unsigned char indices[max_size];
+    permutation(indices, rank);
+
+    out.resize(in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+        out[i] = in[indices[i]];
+}
+
+}
@@ -0,0 +1,125 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"../../Common_Include/mapped_file.h"
+#include<string>
+#include<cstddef>
+#include<cstdint>
+#include<cassert>
+
+// A file holding the index lists of a range of lexicographic ranks, each in
+// a record of fixed size, so the permutation of any rank is found by address
+// arithmetic alone.  Records hold one byte per element or, packed, one nibble
+// per element (the even positions in the low nibbles) for at most 16
+// elements.  The records may start on a huge page boundary, so the mapped
+// data can be backed by huge pages.
+//
+// Layout, all integers little endian:
+//  header      - see lexicographic_dump::header below, padded to data_offset
+//  records     - count records of stride bytes, rank first onwards
+namespace lexicographic_dump {
+
+std::uint32_t const magic   = 0x4450584C;   // "LXPD"
+std::uint16_t const version = 1;
+
+// Header flags.
+std::uint16_t const packed             = 1;
+std::uint16_t const huge_page_aligned  = 2;
+
+// The fixed size file header.
+struct header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t size;             // the permutations' length
+    std::uint16_t flags;
+    std::uint16_t reserved;
+    std::uint32_t stride;           // bytes per record
+    std::uint64_t first;            // rank of the first record
+    std::uint64_t count;            // number of records
+    std::uint64_t data_offset;      // file offset of the first record
+};
+
+std::size_t const header_bytes    = 40;
+std::size_t const huge_page_bytes = std::size_t(1) << 21;
+
+// The largest permutation dumped, that whose ranks fit in 64 bits.
+std::size_t const max_size = 20;
+
+struct options {
+    bool     pack       = false;    // nibble records, at most 16 elements
+    bool     huge_pages = false;    // align the records to a huge page
+    unsigned threads    = 0;        // writers, 0 for all cores
+};
+
+// Write the count permutations of size elements from rank first on.  Each
+// thread unranks the start of its share of the records and steps through the
+// rest, writing straight into the mapped file; unpacked records of
+// lexicographic_block::min_size or more elements are written in blocks.
+// Returns false on an I/O failure or invalid arguments.
+bool write( std::string const& path
+          , std::size_t        size
+          , std::uint64_t      first
+          , std::uint64_t      count
+          , options const&     settings = options());
+
+// Write all size! permutations.
+bool write( std::string const& path
+          , std::size_t        size
+          , options const&     settings = options());
+
+// Memory maps a dump and reads permutations from it by rank.
+class reader {
+public:
+    explicit reader(std::string const& path);
+
+    // Test that the file was mapped and holds a valid dump.
+    bool is_open() const { return data_ != nullptr; }
+
+    header const& info() const { return header_; }
+
+    // Test that the dump holds the rank.
+    bool contains(std::uint64_t rank) const {
+        return rank >= header_.first && rank - header_.first < header_.count;
+    }
+
+    // The record of the rank, stride bytes as stored.
+    std::uint8_t const* record(std::uint64_t rank) const {
+        assert(is_open() && contains(rank));
+        return data_ + (rank - header_.first) * header_.stride;
+    }
+
+    // Copy the index list of the rank into out, of size elements.
+    void permutation(unsigned char* out, std::uint64_t rank) const;
+
+    // Permute the string provided, of size characters, as the rank dictates.
+    void permutation( std::string&       out
+                    , std::string const& in
+                    , std::uint64_t      rank) const;
+
+    // Ask for huge pages to back the mapping, where supported.
+    bool advise_huge_pages() { return file_.advise_huge_pages(); }
+
+private:
+    header               header_;
+    mapped_file          file_;
+    std::uint8_t const*  data_ { nullptr };     // the records
+};
+
+}
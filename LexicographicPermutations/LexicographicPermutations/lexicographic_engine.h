@@ -0,0 +1,158 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"../../Common_Include/factorial_base_manipulation.h"
+#include"../../Common_Include/span.h"
+#include<vector>
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<utility>
+
+// Moves a span from one lexicographic permutation to the next in place, as
+// std::next_permutation does, but ordered by the elements' original
+// positions rather than by comparing them.  The permutation state tells
+// which digit carried, so no comparisons are needed: with k the index of the
+// last digit altered and d its new value, the element at position n-2-k is
+// exchanged with the one at n-d and the positions after n-2-k are reversed.
+template<typename Exchange_, typename Reverse_>
+bool lexicographic_step( factorial_base::Number& state
+                       , std::size_t             size
+                       , Exchange_               exchange
+                       , Reverse_                reverse) {
+
+    if(size < 2)
+        return false;
+
+    auto const k = factorial_base::increment(state);
+
+    // Test end condition.
+    if(state.size() >= size)
+        return false;
+
+    auto const pivot = size - 2 - k;
+    exchange(pivot, size - state[k]);
+    reverse(pivot + 1, size);
+
+    return true;
+}
+
+// Enumerates the permutations of a span of any element type in the order
+// lexicographic_permutation() does, without copying any element.  Alongside
+// the elements the engine keeps the index permutation, whose element i holds
+// the original position of the element now at position i.  Elements that are
+// expensive to move may be left where they are (in_place false) and read
+// through the index permutation instead.
+template< typename T
+        , typename Index_ = std::uint32_t
+        , bool     Direct_ = factorial_base::is_directly_permuted<T>::value >
+class lexicographic_engine {
+public:
+    using element_span = factorial_base::span<T>;
+    using index_span   = factorial_base::span<Index_ const>;
+
+    explicit lexicographic_engine(element_span elements, bool in_place = true)
+    : elements_(elements)
+    , in_place_(in_place)
+    , indices_(elements.size())
+    , state_(elements.size() ? elements.size() - 1 : 0, 0U) {
+        for(std::size_t i = 0; i < indices_.size(); ++i)
+            indices_[i] = Index_(i);
+    }
+
+    // Advance to the next permutation.  Returns false once every permutation
+    // has been visited, leaving the elements as they were but the state past
+    // the last permutation.
+    bool next() {
+        return lexicographic_step( state_, elements_.size()
+                                 , [this](std::size_t i, std::size_t j) {
+                                       std::swap(indices_[i], indices_[j]);
+                                       if(in_place_) {
+                                           using std::swap;
+                                           swap(elements_[i], elements_[j]);
+                                       }
+                                   }
+                                 , [this](std::size_t first, std::size_t last) {
+                                       std::reverse( indices_.begin() + first
+                                                   , indices_.begin() + last);
+                                       if(in_place_)
+                                           std::reverse( elements_.begin() + first
+                                                       , elements_.begin() + last);
+                                   });
+    }
+
+    std::size_t size() const { return elements_.size(); }
+
+    // The element at position i of the current permutation.
+    T& operator[](std::size_t i) const {
+        return elements_[in_place_ ? i : indices_[i]];
+    }
+
+    // The current index permutation.
+    index_span indices() const { return index_span(indices_.data(), indices_.size()); }
+
+    // The current permutation state.
+    factorial_base::Number const& state() const { return state_; }
+
+private:
+    element_span            elements_;
+    bool                    in_place_;
+    std::vector<Index_>     indices_;
+    factorial_base::Number  state_;
+};
+
+// Small trivially copyable elements, such as the integers of an index array,
+// are moved directly and no separate index permutation is kept.
+template<typename T, typename Index_>
+class lexicographic_engine<T, Index_, true> {
+public:
+    using element_span = factorial_base::span<T>;
+
+    // in_place is accepted as the general engine's is, and ignored.
+    explicit lexicographic_engine(element_span elements, bool /*in_place*/ = true)
+    : elements_(elements)
+    , state_(elements.size() ? elements.size() - 1 : 0, 0U) {
+    }
+
+    // Advance to the next permutation.  Returns false once every permutation
+    // has been visited, leaving the elements as they were but the state past
+    // the last permutation.
+    bool next() {
+        return lexicographic_step( state_, elements_.size()
+                                 , [this](std::size_t i, std::size_t j) {
+                                       std::swap(elements_[i], elements_[j]);
+                                   }
+                                 , [this](std::size_t first, std::size_t last) {
+                                       std::reverse( elements_.begin() + first
+                                                   , elements_.begin() + last);
+                                   });
+    }
+
+    std::size_t size() const { return elements_.size(); }
+
+    // The element at position i of the current permutation.
+    T& operator[](std::size_t i) const { return elements_[i]; }
+
+    // The current permutation state.
+    factorial_base::Number const& state() const { return state_; }
+
+private:
+    element_span            elements_;
+    factorial_base::Number  state_;
+};
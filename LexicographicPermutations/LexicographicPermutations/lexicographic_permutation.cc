@@ -17,17 +17,36 @@
 // see <http://www.gnu.org/licenses/>.
 
 #include"../../Common_Include/factorial_base_manipulation.h"
+#include"../../Common_Include/factorial_base_conversions.h"
 using factorial_base::Number;
+#include"../../Common_Include/small_permutation.h"
+#include"../../Common_Include/instrumentation.h"
 #include"lexicographic_permutation.h"
-using std::experimental::generator;
+#include"lexicographic_block.h"
+using frame_arena::generator;
 using std::string;
 #include<algorithm>
 #include<iterator>
+#include<cassert>
+#include<vector>
 
 // Generate a permutation of the first argument dictated by the second
 // argument.
 string generate_permutation(string const& str, Number const& state) {
 
+    // Strings fitting in a vector register are unranked and permuted with
+    // byte shuffles.
+    if(str.size() <= small_permutation::max_size) {
+
+        small_permutation::Shuffle shuffle;
+        small_permutation::unrank_lexicographic(shuffle, state);
+
+        string result(str.size(), '\0');
+        small_permutation::apply(&result[0], str.data(), shuffle, str.size());
+
+        return result;
+    }
+
     string chars{str},              // Copy of the string to be permuted
            result;                  // The permuted string to be returned
 
@@ -45,13 +64,14 @@ string generate_permutation(string const& str, Number const& state) {
                       return value;
                     });
 
-
     return result + chars;
 }
 
-// Return a yield generator enumerating the permutations of the
-// string provided.
-generator<string> lexicographic_permutation(string const& in) {
+namespace {
+
+// Enumerate the permutations of the string provided by incrementing the
+// permutation state and unranking it for each.
+generator<string> lexicographic_steps(string const& in) {
 
     size_t const string_size{in.size()};
 
@@ -69,6 +89,119 @@ generator<string> lexicographic_permutation(string const& in) {
             break;
 
         // Yield the permutation corresponding to the current permutation state.
+        INSTRUMENT_COUNT(permutations, 1);
         co_yield generate_permutation(in, state);
+        INSTRUMENT_COUNT(resumes, 1);
     }
 }
+
+}
+
+// Return a yield generator enumerating the permutations of the
+// string provided.
+generator<string> lexicographic_permutation(string const& in) {
+
+    // Long enough strings are permuted a block at a time.  Rank 0 is the
+    // string itself, which is not yielded.
+    if(in.size() >= lexicographic_block::min_size
+    && in.size() <= lexicographic_block::max_size)
+        return lexicographic_range(in, 1);
+
+    return lexicographic_steps(in);
+}
+
+// Return a yield generator enumerating count permutations of the string
+// provided from the one of rank first.
+generator<string> lexicographic_range( string const&  in
+                                     , std::uint64_t  first
+                                     , std::uint64_t  count) {
+
+    size_t const string_size{in.size()};
+    assert(string_size && string_size <= lexicographic_block::max_size);
+
+    auto const total = std::uint64_t(factorial_base::factorial(string_size));
+    if(first >= total)
+        co_return;
+    count = std::min(count, total - first);
+
+    string result{in};
+
+    // The permutation state advances once per block of the last positions'
+    // orderings.
+    if(string_size >= lexicographic_block::min_size) {
+
+        std::vector<char> block(lexicographic_block::block_size * string_size);
+
+        while(count) {
+
+            auto const taken = std::min<std::uint64_t>(
+                lexicographic_block::block_size - first % lexicographic_block::block_size
+              , count);
+            lexicographic_block::write(block.data(), in.data(), string_size, first, taken);
+            first += taken;
+            count -= taken;
+
+            for(std::size_t i = 0; i < taken; ++i) {
+                result.assign(&block[i * string_size], string_size);
+                INSTRUMENT_COUNT(permutations, 1);
+                co_yield result;
+                INSTRUMENT_COUNT(resumes, 1);
+            }
+        }
+
+        co_return;
+    }
+
+    Number state;
+    factorial_base::to_factorial_base64(state, first, string_size - 1);
+
+    for(; count; --count) {
+
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield generate_permutation(in, state);
+        INSTRUMENT_COUNT(resumes, 1);
+
+        factorial_base::increment(state);
+    }
+}
+
+// Return a yield generator enumerating every stride-th permutation of the
+// string provided.
+generator<string> lexicographic_stride( string const&  in
+                                      , Number         first
+                                      , Number         stride
+                                      , std::uint64_t  count) {
+
+    assert(factorial_base::compare(stride, Number{}) > 0);
+
+    if(in.empty())
+        co_return;
+
+    // The permutation state has one digit fewer than the string; a state
+    // grown past that is beyond the final permutation.
+    auto const digits = in.size() - 1;
+
+    while(first.size() > digits && !first.back())
+        first.pop_back();
+    if(first.size() < digits)
+        first.resize(digits, 0U);
+
+    for(; count && first.size() <= digits; --count) {
+
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield generate_permutation(in, first);
+        INSTRUMENT_COUNT(resumes, 1);
+
+        factorial_base::add(first, stride);
+    }
+}
+
+// Return a yield generator enumerating count evenly spread permutations of
+// the string provided.
+generator<string> lexicographic_sample(string const& in, unsigned count) {
+
+    Number stride;
+    factorial_base::spread(stride, in.size(), count);
+
+    return lexicographic_stride(in, Number{}, stride, count);
+}
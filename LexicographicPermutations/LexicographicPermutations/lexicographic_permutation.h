@@ -18,9 +18,40 @@
 
 #pragma once
 #include<string>
-#include<experimental\generator>
+#include<cstdint>
+#include<limits>
+#include"../../Common_Include/factorial_base_common.h"
+#include"../../Common_Include/frame_arena.h"
 
 // Return a yield generator enumerating the permutations of the
 // string provided.
-std::experimental::generator<std::string>
+frame_arena::generator<std::string>
 lexicographic_permutation(std::string const& in);
+
+// Return a yield generator enumerating up to count permutations of the
+// string provided in lexicographic order, starting from the one of rank
+// first (the string itself has rank 0).  Strings of at most 20 characters,
+// whose ranks fit in 64 bits; those of 10 or more are permuted a block of
+// the last positions' orderings at a time.
+frame_arena::generator<std::string>
+lexicographic_range( std::string const&            in
+                   , std::uint64_t                 first
+                   , std::uint64_t                 count
+                         = std::numeric_limits<std::uint64_t>::max());
+
+// Return a yield generator enumerating every stride-th permutation of the
+// string provided in lexicographic order, starting from the one of rank
+// first (the string itself has rank 0), up to count of them.  Each step costs
+// one factorial base addition and one unranking regardless of the stride.
+frame_arena::generator<std::string>
+lexicographic_stride( std::string const&            in
+                    , factorial_base::Number        first
+                    , factorial_base::Number        stride
+                    , std::uint64_t                 count
+                          = std::numeric_limits<std::uint64_t>::max());
+
+// Return a yield generator enumerating count permutations of the string
+// provided spread evenly over lexicographic order, starting from the string
+// itself.
+frame_arena::generator<std::string>
+lexicographic_sample(std::string const& in, unsigned count);
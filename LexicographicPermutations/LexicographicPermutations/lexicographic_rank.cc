@@ -0,0 +1,122 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"lexicographic_rank.h"
+#include"../../Common_Include/parallel_for.h"
+using factorial_base::Number;
+using std::string;
+using std::vector;
+#include<cassert>
+#if defined(_MSC_VER)
+#   include<intrin.h>
+#endif
+
+// Count the set bits of the argument.
+inline unsigned popcount64(std::uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return unsigned(__popcnt64(value));
+#elif defined(_MSC_VER)
+    return unsigned(__popcnt(unsigned(value)) + __popcnt(unsigned(value >> 32)));
+#else
+    return unsigned(__builtin_popcountll(value));
+#endif
+}
+
+// Compute the permutation state which generates the index list provided.
+// The digit for position i counts the indices not yet taken by positions
+// before i which are less than the index at i.
+void lexicographic_rank(Number& out, vector<unsigned> const& permutation) {
+
+    auto const size = permutation.size();
+    out.assign(size ? size - 1 : 0, 0U);
+
+    // Fenwick tree over the indices taken so far (1-based).
+    vector<unsigned> taken(size + 1, 0U);
+
+    for(std::size_t position = 0; position + 1 < size; ++position) {
+
+        auto const index = permutation[position];
+        assert(index < size);
+
+        // Count taken indices below this one.
+        unsigned below = 0;
+        for(auto i = index; i; i &= i - 1)
+            below += taken[i];
+
+        out[size - 2 - position] = index - below;
+
+        for(auto i = index + 1; i <= size; i += i & (0 - i))
+            ++taken[i];
+    }
+}
+
+// Return the rank of the index list provided.  The rank is accumulated by
+// Horner's Rule, most significant digit first.
+std::uint64_t lexicographic_rank( unsigned char const* permutation
+                                , std::size_t          size) {
+
+    assert(size <= max_rank64_size);
+
+    std::uint64_t taken = 0,
+                  rank  = 0;
+
+    for(std::size_t position = 0; position + 1 < size; ++position) {
+
+        auto const index = permutation[position];
+        auto const below = std::uint64_t(1) << index;
+
+        rank = rank * (size - position) + index - popcount64(taken & (below - 1));
+        taken |= below;
+    }
+
+    return rank;
+}
+
+// Return the rank of a permutation of a string of distinct characters.
+std::uint64_t lexicographic_rank( string const& permuted
+                                , string const& original) {
+
+    assert(permuted.size() == original.size());
+    assert(permuted.size() <= max_rank64_size);
+
+    // Map each character to its position in the original string.
+    unsigned char positions[256] = {};
+    for(std::size_t i = 0; i < original.size(); ++i)
+        positions[(unsigned char)original[i]] = (unsigned char)i;
+
+    unsigned char permutation[max_rank64_size];
+    for(std::size_t i = 0; i < permuted.size(); ++i)
+        permutation[i] = positions[(unsigned char)permuted[i]];
+
+    return lexicographic_rank(permutation, permuted.size());
+}
+
+// Rank count index lists stored consecutively, across threads.
+void lexicographic_rank_batch( unsigned char const* permutations
+                             , std::size_t          size
+                             , std::size_t          count
+                             , std::uint64_t*       ranks
+                             , unsigned             threads) {
+
+    factorial_base::parallel_for(count,
+        [=](std::size_t first, std::size_t last) {
+            for(auto i = first; i < last; ++i)
+                ranks[i] = lexicographic_rank(permutations + i * size, size);
+        },
+        threads);
+}
@@ -0,0 +1,54 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"../../Common_Include/factorial_base_common.h"
+#include<vector>
+#include<string>
+#include<cstddef>
+#include<cstdint>
+
+// Permutations are ranked as index lists, where element i holds the position
+// in the original string of the character moved to position i.  The rank is
+// the one lexicographic_permutation() enumerates them in; the original string
+// has rank 0 and is not yielded.
+
+// The largest permutation whose rank fits in 64 bits.
+std::size_t const max_rank64_size = 20;
+
+// Compute the permutation state which generates the index list provided.
+// Runs in O(n log n) for any length by use of a Fenwick tree.
+void lexicographic_rank( factorial_base::Number&       out
+                       , std::vector<unsigned> const& permutation);
+
+// Return the rank of the index list provided of at most max_rank64_size
+// elements.  Runs in O(n) by counting set bits.
+std::uint64_t lexicographic_rank( unsigned char const* permutation
+                                , std::size_t          size);
+
+// Return the rank of a permutation of a string of distinct characters.
+std::uint64_t lexicographic_rank( std::string const& permuted
+                                , std::string const& original);
+
+// Rank count index lists, each of size elements, stored consecutively.  The
+// work is split across the given number of threads (0 for all cores).
+void lexicographic_rank_batch( unsigned char const* permutations
+                             , std::size_t          size
+                             , std::size_t          count
+                             , std::uint64_t*       ranks
+                             , unsigned             threads = 0);
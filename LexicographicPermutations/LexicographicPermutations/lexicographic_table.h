@@ -0,0 +1,94 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of LexicographicPermutations.
+//
+// LexicographicPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// LexicographicPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with LexicographicPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"../../Common_Include/factorial_base_common.h"
+#include"../../Common_Include/instrumentation.h"
+#include<string>
+#include<cstddef>
+#include<cassert>
+#include"../../Common_Include/frame_arena.h"
+
+// The index lists of all permutations of an N element string in
+// lexicographic order, i.e. indexed by rank.
+template<std::size_t N>
+struct lexicographic_table {
+    static_assert(N >= 1, "a permutation table requires at least one element");
+    static constexpr std::size_t size = factorial_base::factorial(N);
+
+    unsigned char permutations[size][N];
+};
+
+// Build the permutation table for an N element string at compile time.
+template<std::size_t N>
+constexpr lexicographic_table<N> make_lexicographic_table() {
+
+    lexicographic_table<N> table{};
+
+    // The permutation state; only the first N-1 digits are used.
+    unsigned digits[N] = {};
+
+    for(std::size_t rank = 0; rank < table.size; ++rank) {
+
+        unsigned char chars[N] = {};
+        for(unsigned i = 0; i < N; ++i)
+            chars[i] = (unsigned char)i;
+
+        // Select the index of the most significant digit first, erasing it
+        // from those remaining, as generate_permutation() does.
+        unsigned remaining = N;
+        for(unsigned position = 0; position + 1 < N; ++position) {
+
+            auto const digit = digits[N - 2 - position];
+            table.permutations[rank][position] = chars[digit];
+
+            for(unsigned i = digit; i + 1 < remaining; ++i)
+                chars[i] = chars[i + 1];
+            --remaining;
+        }
+        table.permutations[rank][N - 1] = chars[0];
+
+        // Increment the permutation state as factorial_base::increment() does.
+        for(unsigned i = 0; i + 1 < N && ++digits[i] > i + 1; ++i)
+            digits[i] = 0;
+    }
+
+    return table;
+}
+
+// Return a yield generator enumerating the permutations of the N element
+// string provided by walking its compile time permutation table.
+template<std::size_t N>
+frame_arena::generator<std::string>
+lexicographic_permutation(std::string const& in) {
+
+    static constexpr lexicographic_table<N> table = make_lexicographic_table<N>();
+
+    assert(in.size() == N);
+    std::string result{in};
+
+    // Rank 0 is the string itself, which lexicographic_permutation() does not
+    // yield either.
+    for(std::size_t rank = 1; rank < table.size; ++rank) {
+        for(std::size_t i = 0; i < N; ++i)
+            result[i] = in[table.permutations[rank][i]];
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield result;
+        INSTRUMENT_COUNT(resumes, 1);
+    }
+}
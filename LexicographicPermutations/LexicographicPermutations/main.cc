@@ -16,24 +16,69 @@
 // along with LexicographicPermutations.  If not,
 // see <http://www.gnu.org/licenses/>.
 
-#include"lexicographic_permutation.h"
+#include"lexicographic_table.h"
+#include"lexicographic_dump.h"
 using std::string;
 #include<iostream>
+#include<vector>
 using std::cout;
 #include<iterator>
+#include<cstdlib>
+#include"../../Common_Include/instrumentation.h"
+
+// Write a dump file from the arguments
+//   dump <path> <size> [<first> <count>] [packed] [huge]
+int dump(int argc, char** argv) {
+
+    std::vector<string> args(argv + 2, argv + argc);
+    lexicographic_dump::options settings;
+
+    // Trailing option words.
+    while(!args.empty() && (args.back() == "packed" || args.back() == "huge")) {
+        (args.back() == "packed" ? settings.pack : settings.huge_pages) = true;
+        args.pop_back();
+    }
+
+    if(args.size() != 2 && args.size() != 4) {
+        std::cerr << "Usage: dump <path> <size> [<first> <count>] [packed] [huge]\n";
+        return -1;
+    }
+
+    auto const size = std::size_t(std::strtoul(args[1].c_str(), nullptr, 10));
+
+    bool const written = args.size() == 2
+        ? lexicographic_dump::write(args[0], size, settings)
+        : lexicographic_dump::write( args[0], size
+                                   , std::strtoull(args[2].c_str(), nullptr, 10)
+                                   , std::strtoull(args[3].c_str(), nullptr, 10)
+                                   , settings);
+
+    if(!written) {
+        std::cerr << "Failed to write " << args[0] << '\n';
+        return -1;
+    }
+
+    return 0;
+}
 
 // Program's entry point.
-int main() {
+int main(int argc, char** argv) {
+
+    if(argc > 1 && string(argv[1]) == "dump")
+        return dump(argc, argv);
 
     // The string to permute.
     string to_permute{"abcd"};
     cout << to_permute << '\n';
 
-    // Iterate over permutations of the string, displaying results.
-    auto generator = lexicographic_permutation(to_permute);
+    // Iterate over permutations of the string, displaying results.  The
+    // string's length is known at compile time, so its permutation table is
+    // walked rather than computing each permutation.
+    auto generator = lexicographic_permutation<4>(to_permute);
     std::copy( generator.begin()
              , generator.end()
              , std::ostream_iterator<string>(cout, "\n") );
 
+    INSTRUMENT_REPORT(std::cerr);
     return 0;
 }
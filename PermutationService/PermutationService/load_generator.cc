@@ -0,0 +1,196 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"load_generator.h"
+#include"local_socket.h"
+#include"../../Common_Include/random_permutation.h"
+#include"../../Common_Include/factorial_base_common.h"
+#include"../../Spellephone/Spellephone/Keypad.h"
+#include<algorithm>
+#include<chrono>
+#include<thread>
+#include<vector>
+#include<mutex>
+using std::string;
+using std::vector;
+using clock_type = std::chrono::steady_clock;
+using namespace query_protocol;
+
+namespace load_generator {
+
+namespace {
+
+// Append the next request with the given id.
+void append_request( string& out, std::uint32_t id, options const& settings
+                   , random_permutation::sampler& permutations
+                   , random_permutation::engine& random) {
+
+    char payload[max_payload];
+    std::size_t bytes = 0;
+
+    switch(settings.operation) {
+
+    case operation::lexicographic_rank:
+    case operation::swap_rank:
+        permutations.sample(reinterpret_cast<unsigned char*>(payload));
+        bytes = settings.size;
+        break;
+
+    case operation::lexicographic_unrank:
+    case operation::swap_unrank:
+        put(payload, random() % factorial_base::factorial(settings.size), 8);
+        bytes = 8;
+        break;
+
+    case operation::spelling_count:
+    case operation::spelling:
+        if(settings.operation == operation::spelling) {
+            put(payload, random() % Spellephone::spellingCount(settings.phoneNumber), 8);
+            bytes = 8;
+        }
+        bytes += settings.phoneNumber.copy(payload + bytes, max_payload - bytes);
+        break;
+    }
+
+    append( out, id, std::uint8_t(settings.operation), std::uint8_t(settings.size)
+          , payload, bytes);
+}
+
+// One connection's share of the load.  Returns false if it could not
+// connect.
+bool drive( string const& path, options const& settings, unsigned stream
+          , vector<double>& latencies, std::uint64_t& failed) {
+
+    auto const server = local_socket::connect(path);
+    if(!server.is_open())
+        return false;
+
+    // Spellings take no permutation length.
+    auto const length = settings.size >= 1 && settings.size <= max_size ? settings.size : 1;
+    random_permutation::sampler permutations(length, 1, stream);
+    random_permutation::engine random(2, stream);
+
+    // The send time of each request in flight, by id modulo depth.
+    vector<clock_type::time_point> sent(settings.depth);
+    std::uint64_t issued = 0,
+                  received = 0;
+
+    string output, input;
+    vector<char> chunk(1 << 16);
+    frame response;
+
+    // Issue requests up to the depth, all sent in one write.
+    auto const top_up = [&] {
+        output.clear();
+        auto const now = clock_type::now();
+        while(issued < settings.requests && issued - received < settings.depth) {
+            sent[issued % settings.depth] = now;
+            append_request(output, std::uint32_t(issued++), settings, permutations, random);
+        }
+        return output.empty() || server.write(output.data(), output.size());
+    };
+
+    if(!top_up())
+        return true;
+
+    while(received < settings.requests) {
+
+        auto const got = server.read(chunk.data(), chunk.size());
+        if(got <= 0)
+            break;
+        input.append(chunk.data(), std::size_t(got));
+
+        auto const now = clock_type::now();
+        std::size_t offset = 0;
+
+        while(take(response, input, offset) > 0) {
+            latencies.push_back(std::chrono::duration<double, std::micro>(
+                now - sent[response.id % settings.depth]).count());
+            failed += response.code != std::uint8_t(status::ok);
+            ++received;
+        }
+
+        input.erase(0, offset);
+
+        if(!top_up())
+            break;
+    }
+
+    return true;
+}
+
+}
+
+bool valid(options const& settings) {
+
+    auto const spelling = settings.operation == operation::spelling_count
+                       || settings.operation == operation::spelling;
+
+    return settings.connections && settings.depth
+        && (spelling || (settings.size >= 1 && settings.size <= max_size));
+}
+
+report run(string const& path, options const& settings) {
+
+    report result;
+
+    if(!valid(settings))
+        return result;
+
+    vector<vector<double>> latencies(settings.connections);
+    vector<std::uint64_t> failures(settings.connections, 0);
+    vector<char> connected(settings.connections, 0);
+    vector<std::thread> threads;
+
+    auto const start = clock_type::now();
+
+    for(unsigned c = 0; c < settings.connections; ++c)
+        threads.emplace_back([&, c] {
+            latencies[c].reserve(std::size_t(settings.requests));
+            connected[c] = drive(path, settings, c, latencies[c], failures[c]);
+        });
+
+    for(auto& thread : threads)
+        thread.join();
+
+    result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    vector<double> all;
+    for(unsigned c = 0; c < settings.connections; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        result.failed += failures[c];
+        result.connected = result.connected || connected[c];
+    }
+
+    result.completed = all.size();
+    result.per_second = result.seconds > 0 ? result.completed / result.seconds : 0;
+
+    if(!all.empty()) {
+        auto const percentile = [&all](double p) {
+            auto const at = all.begin() + std::ptrdiff_t(p * (all.size() - 1));
+            std::nth_element(all.begin(), at, all.end());
+            return *at;
+        };
+        result.p50_us = percentile(0.50);
+        result.p99_us = percentile(0.99);
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,56 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"query_protocol.h"
+#include<string>
+#include<cstdint>
+
+// Drives a query server with pipelined requests of one operation and reports
+// throughput and latency.
+namespace load_generator {
+
+struct options {
+    unsigned                  connections = 4;
+    std::uint64_t             requests    = 100000;     // per connection
+    unsigned                  depth       = 32;         // in flight per connection
+    query_protocol::operation operation   = query_protocol::operation::lexicographic_unrank;
+    unsigned                  size        = 12;         // permutation length
+    std::string               phoneNumber = "(555) 867-5309";
+};
+
+struct report {
+    std::uint64_t completed = 0,
+                  failed    = 0;        // answered with an error status
+    double        seconds   = 0,
+                  per_second = 0,
+                  p50_us    = 0,        // latency percentiles
+                  p99_us    = 0;
+    bool          connected = false;
+};
+
+// Test that the options can be run: at least one connection and request in
+// flight, and for permutation operations a size from 1 to max_size.
+bool valid(options const& settings);
+
+// Each connection keeps depth requests in flight, sending a new request for
+// each response read, with random ranks, index lists or spelling indices.  Invalid options are
+// not run.
+report run(std::string const& path, options const& settings);
+
+}
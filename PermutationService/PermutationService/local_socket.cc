@@ -0,0 +1,228 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"local_socket.h"
+#include<cstring>
+#include<utility>
+
+#if defined(_WIN32)
+#   include<winsock2.h>
+#   include<afunix.h>
+#   pragma comment(lib, "ws2_32.lib")
+#else
+#   include<sys/socket.h>
+#   include<sys/stat.h>
+#   include<sys/un.h>
+#   include<unistd.h>
+#   include<cerrno>
+#endif
+
+namespace {
+
+#if defined(_WIN32)
+
+// Start Winsock once, before the first socket.
+struct winsock {
+    winsock() {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    }
+    ~winsock() { WSACleanup(); }
+};
+
+void start_sockets() {
+    static winsock const started;
+}
+
+inline void close_handle(std::uintptr_t handle) { ::closesocket(SOCKET(handle)); }
+
+#else
+
+inline void start_sockets() { }
+inline void close_handle(int handle) { ::close(handle); }
+
+#endif
+
+// Fill in the address of the path, false if it is too long.
+bool address(sockaddr_un& out, std::string const& path) {
+    std::memset(&out, 0, sizeof(out));
+    out.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(out.sun_path))
+        return false;
+    std::memcpy(out.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// Clear the path for binding.  Nothing may be there but a socket nobody is
+// listening on, which is removed; false if anything else is.
+bool remove_stale(std::string const& path, sockaddr_un const& where) {
+
+#if defined(_WIN32)
+    auto const attributes = ::GetFileAttributesA(path.c_str());
+    if(attributes == INVALID_FILE_ATTRIBUTES)
+        return ::GetLastError() == ERROR_FILE_NOT_FOUND;
+
+    // Unix domain sockets are reparse points.
+    if(!(attributes & FILE_ATTRIBUTE_REPARSE_POINT))
+        return false;
+
+    auto const probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(probe == INVALID_SOCKET)
+        return false;
+
+    bool const refused = ::connect( probe, reinterpret_cast<sockaddr const*>(&where)
+                                  , sizeof(where)) == SOCKET_ERROR
+                      && ::WSAGetLastError() == WSAECONNREFUSED;
+    ::closesocket(probe);
+
+    return refused && ::DeleteFileA(path.c_str());
+#else
+    struct stat info;
+    if(::lstat(path.c_str(), &info))
+        return errno == ENOENT;
+
+    if(!S_ISSOCK(info.st_mode))
+        return false;
+
+    auto const probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(probe < 0)
+        return false;
+
+    bool const refused = ::connect( probe, reinterpret_cast<sockaddr const*>(&where)
+                                  , sizeof(where))
+                      && errno == ECONNREFUSED;
+    ::close(probe);
+
+    return refused && !::unlink(path.c_str());
+#endif
+}
+
+}
+
+local_socket::handle_type const local_socket::invalid;
+
+local_socket::~local_socket() {
+    close();
+}
+
+local_socket::local_socket(local_socket&& other)
+: handle_(std::exchange(other.handle_, invalid)) {
+}
+
+local_socket& local_socket::operator=(local_socket&& other) {
+    if(this != &other) {
+        close();
+        handle_ = std::exchange(other.handle_, invalid);
+    }
+    return *this;
+}
+
+local_socket local_socket::listen(std::string const& path) {
+
+    start_sockets();
+
+    sockaddr_un where;
+    if(!address(where, path))
+        return local_socket();
+
+    if(!remove_stale(path, where))
+        return local_socket();
+
+    local_socket result(handle_type(::socket(AF_UNIX, SOCK_STREAM, 0)));
+    if(!result.is_open())
+        return result;
+
+    if(::bind(result.handle_, reinterpret_cast<sockaddr const*>(&where), sizeof(where))
+    || ::listen(result.handle_, SOMAXCONN))
+        result.close();
+
+    return result;
+}
+
+local_socket local_socket::connect(std::string const& path) {
+
+    start_sockets();
+
+    sockaddr_un where;
+    if(!address(where, path))
+        return local_socket();
+
+    local_socket result(handle_type(::socket(AF_UNIX, SOCK_STREAM, 0)));
+
+    if(result.is_open()
+    && ::connect(result.handle_, reinterpret_cast<sockaddr const*>(&where), sizeof(where)))
+        result.close();
+
+    return result;
+}
+
+local_socket local_socket::accept() const {
+    return local_socket(handle_type(::accept(handle_, nullptr, nullptr)));
+}
+
+bool local_socket::is_open() const {
+    return handle_ != invalid;
+}
+
+std::ptrdiff_t local_socket::read(void* out, std::size_t bytes) const {
+
+    for(;;) {
+        auto const got = ::recv(handle_, static_cast<char*>(out), int(bytes), 0);
+#if !defined(_WIN32)
+        if(got < 0 && errno == EINTR)
+            continue;
+#endif
+        return got < 0 ? -1 : std::ptrdiff_t(got);
+    }
+}
+
+bool local_socket::write(void const* in, std::size_t bytes) const {
+
+    auto next = static_cast<char const*>(in);
+
+    while(bytes) {
+#if defined(_WIN32)
+        auto const sent = ::send(handle_, next, int(bytes), 0);
+#else
+        auto const sent = ::send(handle_, next, bytes, MSG_NOSIGNAL);
+        if(sent < 0 && errno == EINTR)
+            continue;
+#endif
+        if(sent <= 0)
+            return false;
+        next  += sent;
+        bytes -= std::size_t(sent);
+    }
+
+    return true;
+}
+
+void local_socket::shutdown() const {
+#if defined(_WIN32)
+    ::shutdown(SOCKET(handle_), SD_BOTH);
+#else
+    ::shutdown(handle_, SHUT_RDWR);
+#endif
+}
+
+void local_socket::close() {
+    if(is_open()) {
+        close_handle(handle_);
+        handle_ = invalid;
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<cstddef>
+#include<cstdint>
+
+// A Unix domain stream socket, listening or connected, closed on
+// destruction.  Windows 10 provides the same sockets through Winsock.
+class local_socket {
+public:
+
+    local_socket() = default;
+    ~local_socket();
+
+    local_socket(local_socket&& other);
+    local_socket& operator=(local_socket&& other);
+
+    // Disallow copy
+    local_socket(local_socket const&) = delete;
+    local_socket& operator=(local_socket const&) = delete;
+
+    // Bind to the path and listen.  A socket file left at the path with no
+    // server listening is replaced; anything else there fails the call.
+    static local_socket listen(std::string const& path);
+
+    // Connect to the server listening at the path.
+    static local_socket connect(std::string const& path);
+
+    // Wait for and return a connection, closed on failure or shutdown.
+    local_socket accept() const;
+
+    bool is_open() const;
+
+    // Read up to bytes, returning how many were read, 0 at the end of the
+    // stream or -1 on failure.
+    std::ptrdiff_t read(void* out, std::size_t bytes) const;
+
+    // Write all bytes.  Returns false on failure.
+    bool write(void const* in, std::size_t bytes) const;
+
+    // Wake any thread blocked reading or accepting on the socket.
+    void shutdown() const;
+
+    void close();
+
+private:
+#if defined(_WIN32)
+    using handle_type = std::uintptr_t;
+    static handle_type const invalid = ~handle_type(0);
+#else
+    using handle_type = int;
+    static handle_type const invalid = -1;
+#endif
+
+    explicit local_socket(handle_type handle): handle_(handle) { }
+
+    handle_type handle_ { invalid };
+};
@@ -0,0 +1,127 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"query_server.h"
+#include"load_generator.h"
+#include<iostream>
+#include<string>
+#include<cstdlib>
+#include<algorithm>
+#include<iterator>
+using std::cout;
+using std::string;
+using query_protocol::operation;
+
+namespace {
+
+struct named_operation {
+    char const* name;
+    operation   code;
+};
+
+named_operation const operations[] = {
+    { "lex-rank",    operation::lexicographic_rank },
+    { "lex-unrank",  operation::lexicographic_unrank },
+    { "swap-rank",   operation::swap_rank },
+    { "swap-unrank", operation::swap_unrank },
+    { "spell-count", operation::spelling_count },
+    { "spell",       operation::spelling }
+};
+
+int usage() {
+    std::cerr << "Usage: PermutationService serve <socket>\n"
+                 "       PermutationService load <socket> [<operation> [<size>"
+                 " [<connections> [<requests> [<depth>]]]]]\n"
+                 "Operations: lex-rank lex-unrank swap-rank swap-unrank"
+                 " spell-count spell\n";
+    return -1;
+}
+
+// Serve queries until killed.
+int serve(string const& path) {
+
+    query_server server(path);
+
+    if(!server.is_open()) {
+        std::cerr << "Failed to listen on " << path << '\n';
+        return -1;
+    }
+
+    server.run();
+    return 0;
+}
+
+// Load a server and report its throughput and latency.
+int load(int argc, char** argv) {
+
+    load_generator::options settings;
+
+    if(argc > 3) {
+        auto const found = std::find_if( std::begin(operations), std::end(operations)
+                                       , [argv](named_operation const& o) {
+                                             return string(argv[3]) == o.name;
+                                         });
+        if(found == std::end(operations))
+            return usage();
+        settings.operation = found->code;
+    }
+
+    if(argc > 4)
+        settings.size = unsigned(std::strtoul(argv[4], nullptr, 10));
+    if(argc > 5)
+        settings.connections = unsigned(std::strtoul(argv[5], nullptr, 10));
+    if(argc > 6)
+        settings.requests = std::strtoull(argv[6], nullptr, 10);
+    if(argc > 7)
+        settings.depth = unsigned(std::strtoul(argv[7], nullptr, 10));
+
+    if(!load_generator::valid(settings)) {
+        std::cerr << "Size must be from 1 to " << query_protocol::max_size
+                  << ", connections and depth at least 1\n";
+        return usage();
+    }
+
+    auto const result = load_generator::run(argv[2], settings);
+
+    if(!result.connected) {
+        std::cerr << "Failed to connect to " << argv[2] << '\n';
+        return -1;
+    }
+
+    cout << result.completed << " queries in " << result.seconds << " s, "
+         << result.per_second << " per second, "
+         << result.failed << " failed\n"
+         << "latency p50 " << result.p50_us << " us, p99 "
+         << result.p99_us << " us\n";
+
+    return 0;
+}
+
+}
+
+// Program's entry point.
+int main(int argc, char** argv) {
+
+    if(argc == 3 && string(argv[1]) == "serve")
+        return serve(argv[2]);
+
+    if(argc >= 3 && argc <= 8 && string(argv[1]) == "load")
+        return load(argc, argv);
+
+    return usage();
+}
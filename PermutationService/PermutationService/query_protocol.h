@@ -0,0 +1,115 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"../../Common_Include/little_endian.h"
+#include<string>
+#include<cstddef>
+#include<cstdint>
+
+// The binary protocol of the query service.  Clients may send any number of
+// requests before reading responses; responses come back in request order on
+// each connection and carry the request's id.
+//
+// Every message is a frame, all integers little endian:
+//  length    - 32 bits, the bytes following
+//  id        - 32 bits, chosen by the client
+//  operation - 8 bits in a request, a status in a response
+//  size      - 8 bits, the permutation's length for permutation operations
+//  reserved  - 16 bits
+//  payload   - as follows
+//
+//  operation              request payload            response payload
+//  lexicographic_rank     size byte index list       64-bit rank
+//  lexicographic_unrank   64-bit rank                size byte index list
+//  swap_rank              size byte index list       64-bit rank
+//  swap_unrank            64-bit rank                size byte index list
+//  spelling_count         phone number               64-bit count
+//  spelling               64-bit index, phone number spelling
+//
+// Index lists and ranks are those of lexicographic_rank() and swap_order.
+// A response with a status other than ok has no payload.
+namespace query_protocol {
+
+enum class operation : std::uint8_t {
+    lexicographic_rank = 1,
+    lexicographic_unrank,
+    swap_rank,
+    swap_unrank,
+    spelling_count,
+    spelling
+};
+
+enum class status : std::uint8_t {
+    ok = 0,
+    invalid                 // malformed or out of range
+};
+
+std::size_t const header_bytes = 12;        // the length field included
+std::size_t const max_payload  = 1024;
+
+// The longest permutation served, that whose ranks fit in 64 bits.
+std::size_t const max_size = 20;
+
+struct frame {
+    std::uint32_t id;
+    std::uint8_t  code;         // an operation or a status
+    std::uint8_t  size;
+    std::string   payload;
+};
+
+using little_endian::put;
+using little_endian::get;
+
+// Append a frame to out.
+inline void append( std::string& out, std::uint32_t id, std::uint8_t code
+                  , std::uint8_t size, char const* payload, std::size_t bytes) {
+    char header[header_bytes] = {};
+    put(header, header_bytes - 4 + bytes, 4);
+    put(header + 4, id, 4);
+    header[8] = char(code);
+    header[9] = char(size);
+    out.append(header, header_bytes);
+    out.append(payload, bytes);
+}
+
+// Take the frame starting at offset in into out, advancing offset past it.
+// Returns 0 if the frame is incomplete, -1 if it is malformed, else 1.
+inline int take(frame& out, std::string const& in, std::size_t& offset) {
+
+    if(in.size() - offset < header_bytes)
+        return 0;
+
+    auto const at = in.data() + offset;
+    auto const length = get(at, 4);
+
+    if(length < header_bytes - 4 || length - (header_bytes - 4) > max_payload)
+        return -1;
+    if(in.size() - offset - 4 < length)
+        return 0;
+
+    out.id   = std::uint32_t(get(at + 4, 4));
+    out.code = std::uint8_t(at[8]);
+    out.size = std::uint8_t(at[9]);
+    out.payload.assign(at + header_bytes, std::size_t(length) - (header_bytes - 4));
+
+    offset += 4 + std::size_t(length);
+    return 1;
+}
+
+}
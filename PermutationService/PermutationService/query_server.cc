@@ -0,0 +1,370 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"query_server.h"
+#include"../../LexicographicPermutations/LexicographicPermutations/lexicographic_rank.h"
+#include"../../SingleSwapPermutations/SingleSwapPermutations/swap_rank.h"
+#include"../../Spellephone/Spellephone/Keypad.h"
+#include"../../Common_Include/factorial_base_conversions.h"
+#include"../../Common_Include/small_permutation.h"
+#include<map>
+#include<cstdio>
+#include<cstring>
+using std::string;
+using std::vector;
+using namespace query_protocol;
+
+namespace {
+
+// A request's place: its batch and index within it.
+struct place {
+    std::size_t batch,
+                index;
+};
+
+// Test that the bytes are an index list of their length.
+bool is_index_list(string const& in) {
+    std::uint32_t seen = 0;
+    for(auto ch : in) {
+        auto const i = unsigned(std::uint8_t(ch));
+        if(i >= in.size() || seen >> i & 1)
+            return false;
+        seen |= std::uint32_t(1) << i;
+    }
+    return true;
+}
+
+}
+
+query_server::query_server(string const& path)
+: listener_(local_socket::listen(path))
+, path_(path) {
+
+    if(listener_.is_open())
+        worker_ = std::thread(&query_server::work, this);
+}
+
+query_server::~query_server() {
+    stop();
+}
+
+void query_server::run() {
+
+    while(!stopping_) {
+
+        auto client = listener_.accept();
+        if(!client.is_open())
+            continue;
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if(stopping_)
+            break;
+
+        // Join the threads of connections since closed.
+        for(auto i = connections_.begin(); i != connections_.end(); )
+            if(i->finished) {
+                i->thread.join();
+                i = connections_.erase(i);
+            } else
+                ++i;
+
+        connections_.emplace_back();
+        auto& added = connections_.back();
+        added.socket = std::move(client);
+        added.thread = std::thread(&query_server::serve, this, std::ref(added));
+    }
+}
+
+void query_server::stop() {
+
+    if(!listener_.is_open())
+        return;
+
+    stopping_ = true;
+    listener_.shutdown();
+
+    // The connections are taken out of the list before joining, as their
+    // threads lock it on the way out.
+    std::list<connection> closing;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        closing.splice(closing.end(), connections_);
+    }
+
+    for(auto& client : closing)
+        client.socket.shutdown();
+    for(auto& client : closing)
+        client.thread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        worker_stopping_ = true;
+    }
+    submitted_.notify_one();
+    worker_.join();
+
+    listener_.close();
+    std::remove(path_.c_str());
+}
+
+// Read whatever the client has sent, answer every whole request in it as one
+// batch and write the responses together.
+void query_server::serve(connection& client) {
+
+    string input;
+    vector<char> chunk(1 << 16);
+    frame request;
+
+    for(;;) {
+
+        auto const got = client.socket.read(chunk.data(), chunk.size());
+        if(got <= 0)
+            break;
+        input.append(chunk.data(), std::size_t(got));
+
+        batch work;
+        std::size_t offset = 0;
+        int taken;
+
+        while((taken = take(request, input, offset)) > 0)
+            work.requests.push_back(std::move(request));
+
+        if(taken < 0)
+            break;
+
+        input.erase(0, offset);
+
+        if(work.requests.empty())
+            continue;
+
+        submit(work);
+
+        if(!client.socket.write(work.responses.data(), work.responses.size()))
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    client.finished = true;
+}
+
+void query_server::submit(batch& work) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_.push_back(&work);
+    submitted_.notify_one();
+    answered_.wait(lock, [&work] { return work.done; });
+}
+
+// Take every batch waiting at once.
+void query_server::work() {
+
+    vector<batch*> taken;
+
+    for(;;) {
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            submitted_.wait(lock, [this] { return !waiting_.empty() || worker_stopping_; });
+            if(waiting_.empty())
+                return;
+            taken.assign(waiting_.begin(), waiting_.end());
+            waiting_.clear();
+        }
+
+        answer(taken);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for(auto work : taken)
+                work->done = true;
+        }
+        answered_.notify_all();
+    }
+}
+
+swap_order const& query_server::order(std::size_t size) {
+    if(!orders_[size])
+        orders_[size].reset(new swap_order(size));
+    return *orders_[size];
+}
+
+void query_server::answer(vector<batch*> const& batches) {
+
+    // Each request's status and payload, by batch.
+    vector<vector<frame>> answers(batches.size());
+
+    // The valid requests grouped by operation and length.
+    std::map<unsigned, vector<place>> groups;
+
+    for(std::size_t b = 0; b < batches.size(); ++b) {
+
+        auto const& requests = batches[b]->requests;
+        answers[b].resize(requests.size());
+
+        for(std::size_t i = 0; i < requests.size(); ++i) {
+
+            auto const& request = requests[i];
+            auto& response = answers[b][i];
+            response.id = request.id;
+            response.code = std::uint8_t(status::invalid);
+            response.size = request.size;
+
+            bool valid;
+            auto const size = std::size_t(request.size);
+
+            switch(operation(request.code)) {
+            case operation::lexicographic_rank:
+            case operation::swap_rank:
+                valid = size && size <= max_size && request.payload.size() == size
+                     && is_index_list(request.payload);
+                break;
+            case operation::lexicographic_unrank:
+            case operation::swap_unrank:
+                valid = size && size <= max_size && request.payload.size() == 8
+                     && get(request.payload.data(), 8)
+                        < std::uint64_t(factorial_base::factorial(size));
+                break;
+            case operation::spelling_count:
+                valid = true;
+                break;
+            case operation::spelling:
+                valid = request.payload.size() >= 8;
+                break;
+            default:
+                valid = false;
+            }
+
+            if(valid)
+                groups[unsigned(request.code) << 8 | request.size].push_back(place{ b, i });
+        }
+    }
+
+    vector<std::uint8_t> permutations, digits;
+    vector<std::uint64_t> ranks;
+    string spelled;
+
+    for(auto const& group : groups) {
+
+        auto const code = operation(group.first >> 8);
+        auto const size = std::size_t(group.first & 0xFF);
+        auto const& members = group.second;
+        auto const count = members.size();
+
+        auto const request = [&](std::size_t m) -> frame const& {
+            return batches[members[m].batch]->requests[members[m].index];
+        };
+        auto const response = [&](std::size_t m) -> frame& {
+            return answers[members[m].batch][members[m].index];
+        };
+        auto const respond_rank = [&](std::size_t m, std::uint64_t value) {
+            char bytes[8];
+            put(bytes, value, 8);
+            response(m).code = std::uint8_t(status::ok);
+            response(m).payload.assign(bytes, 8);
+        };
+
+        switch(code) {
+
+        case operation::lexicographic_rank:
+        case operation::swap_rank:
+
+            permutations.resize(count * size);
+            ranks.resize(count);
+            for(std::size_t m = 0; m < count; ++m)
+                std::memcpy(&permutations[m * size], request(m).payload.data(), size);
+
+            if(code == operation::lexicographic_rank)
+                lexicographic_rank_batch(permutations.data(), size, count, ranks.data(), 1);
+            else
+                swap_rank_batch(order(size), permutations.data(), count, ranks.data(), 1);
+
+            for(std::size_t m = 0; m < count; ++m)
+                respond_rank(m, ranks[m]);
+            break;
+
+        case operation::lexicographic_unrank:
+
+            ranks.resize(count);
+            digits.resize(count * (size - 1) + 1);
+            for(std::size_t m = 0; m < count; ++m)
+                ranks[m] = get(request(m).payload.data(), 8);
+
+            factorial_base::to_factorial_base64(digits.data(), ranks.data(), count, size - 1);
+
+            for(std::size_t m = 0; m < count; ++m) {
+                auto& out = response(m);
+                out.code = std::uint8_t(status::ok);
+                out.payload.resize(size);
+                for(std::size_t i = 0; i < size; ++i)
+                    out.payload[i] = char(i);
+                small_permutation::unrank_lexicographic( &out.payload[0], out.payload.data()
+                                                       , &digits[m * (size - 1)], size);
+            }
+            break;
+
+        case operation::swap_unrank:
+
+            permutations.resize(size);
+            for(std::size_t m = 0; m < count; ++m) {
+                order(size).unrank(permutations.data(), get(request(m).payload.data(), 8));
+                response(m).code = std::uint8_t(status::ok);
+                response(m).payload.assign(permutations.begin(), permutations.end());
+            }
+            break;
+
+        case operation::spelling_count:
+
+            for(std::size_t m = 0; m < count; ++m)
+                respond_rank(m, Spellephone::spellingCount(request(m).payload));
+            break;
+
+        case operation::spelling:
+
+            for(std::size_t m = 0; m < count; ++m) {
+
+                auto const& in = request(m).payload;
+                auto const index = get(in.data(), 8);
+                string const number(in, 8);
+
+                if(index < Spellephone::spellingCount(number)) {
+                    Spellephone::spell(spelled, number, index);
+                    response(m).code = std::uint8_t(status::ok);
+                    response(m).payload = spelled;
+                }
+            }
+            break;
+        }
+    }
+
+    for(std::size_t b = 0; b < batches.size(); ++b) {
+
+        auto& out = batches[b]->responses;
+        out.clear();
+
+        for(auto const& response : answers[b])
+            append( out, response.id, response.code, response.size
+                  , response.payload.data(), response.payload.size());
+    }
+
+    requests_ += [&] {
+        std::uint64_t total = 0;
+        for(auto work : batches)
+            total += work->requests.size();
+        return total;
+    }();
+    ++batches_;
+}
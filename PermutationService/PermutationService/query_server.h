@@ -0,0 +1,108 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of PermutationService.
+//
+// PermutationService is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// PermutationService is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PermutationService.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"query_protocol.h"
+#include"local_socket.h"
+#include<string>
+#include<vector>
+#include<deque>
+#include<memory>
+#include<mutex>
+#include<condition_variable>
+#include<thread>
+#include<atomic>
+#include<list>
+
+class swap_order;
+
+// Answers query_protocol requests on a Unix domain socket.  Each connection
+// has a thread reading every request the client has pipelined so far as one
+// batch.  A single worker takes the batches waiting from all connections at
+// once, groups their requests by operation and length, and answers each
+// group through the batch kernels.  The connection thread then writes the
+// batch's responses in one write.
+class query_server {
+public:
+
+    explicit query_server(std::string const& path);
+    ~query_server();
+
+    // Disallow copy and move
+    query_server(query_server const&) = delete;
+    query_server& operator=(query_server const&) = delete;
+
+    // Test that the socket is listening.
+    bool is_open() const { return listener_.is_open(); }
+
+    // Accept and serve connections until stop() is called.
+    void run();
+
+    // Stop accepting, close the connections and wait for their threads.
+    void stop();
+
+    // The requests answered and the batches they were answered in.
+    std::uint64_t requests() const { return requests_; }
+    std::uint64_t batches() const { return batches_; }
+
+private:
+
+    // The requests one connection read at once, and their responses.
+    struct batch {
+        std::vector<query_protocol::frame> requests;
+        std::string                        responses;
+        bool                               done { false };
+    };
+
+    struct connection {
+        local_socket socket;
+        std::thread  thread;
+        bool         finished { false };
+    };
+
+    void serve(connection& client);
+
+    // Hand a batch to the worker and wait for its responses.
+    void submit(batch& work);
+
+    void work();
+
+    // Answer the requests of the batches taken together.
+    void answer(std::vector<batch*> const& batches);
+
+    swap_order const& order(std::size_t size);
+
+    local_socket                              listener_;
+    std::string                               path_;
+    std::atomic<bool>                         stopping_ { false };
+    bool                                      worker_stopping_ { false };
+
+    std::mutex                                mutex_;
+    std::condition_variable                   submitted_,
+                                              answered_;
+    std::deque<batch*>                        waiting_;
+    std::thread                               worker_;
+
+    std::list<connection>                     connections_;
+    std::mutex                                connections_mutex_;
+
+    std::unique_ptr<swap_order>               orders_[query_protocol::max_size + 1];
+
+    std::atomic<std::uint64_t>                requests_ { 0 },
+                                              batches_  { 0 };
+};
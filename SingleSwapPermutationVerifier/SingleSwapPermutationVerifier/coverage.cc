@@ -0,0 +1,224 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutationVerifier.
+//
+// SingleSwapPermutationVerifier is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutationVerifier is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutationVerifier.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"coverage.h"
+#include"../../Common_Include/factorial_base_conversions.h"
+#include"../../Common_Include/small_permutation.h"
+#include"../../Common_Include/parallel_for.h"
+#include"../../SingleSwapPermutations/SingleSwapPermutations/permutation_from_swap.h"
+#include"../../SingleSwapPermutations/SingleSwapPermutations/swap_rank.h"
+#include"../../LexicographicPermutations/LexicographicPermutations/lexicographic_permutation.h"
+#include"../../LexicographicPermutations/LexicographicPermutations/lexicographic_rank.h"
+using factorial_base::Number;
+using std::string;
+#include<atomic>
+#include<memory>
+#include<mutex>
+#include<algorithm>
+#include<utility>
+#include<cassert>
+
+namespace {
+
+// One bit per rank, set concurrently.
+class visited_bitmap {
+public:
+
+    explicit visited_bitmap(std::uint64_t bits)
+    : bits_(bits)
+    , words_(new std::atomic<std::uint64_t>[(bits + 63) / 64]) {
+        factorial_base::parallel_for( std::size_t((bits + 63) / 64)
+                                    , [this](std::size_t first, std::size_t last) {
+                                          for(; first < last; ++first)
+                                              words_[first].store( 0
+                                                                 , std::memory_order_relaxed);
+                                      });
+    }
+
+    // Mark the rank, returning true when it was already marked.
+    bool mark(std::uint64_t rank) {
+        std::uint64_t const bit = std::uint64_t(1) << (rank & 63);
+        return (words_[rank >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) != 0;
+    }
+
+    // Invoke visit(rank) on each unmarked rank of [first..last).
+    template<typename Visit_>
+    void for_each_clear(std::uint64_t first, std::uint64_t last, Visit_ visit) const {
+        for(auto rank = first; rank < last; ++rank)
+            if(!(words_[rank >> 6].load(std::memory_order_relaxed)
+                 >> (rank & 63) & 1))
+                visit(rank);
+    }
+
+    std::uint64_t size() const { return bits_; }
+
+private:
+    std::uint64_t                              bits_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+};
+
+// Collects offending ranks from all threads.
+class offenders {
+public:
+
+    offenders(std::uint64_t& count, std::vector<std::uint64_t>& ranks
+             , std::size_t limit)
+    : count_(count), ranks_(ranks), limit_(limit) {
+    }
+
+    void add(std::uint64_t rank) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(ranks_.size() < limit_)
+            ranks_.push_back(rank);
+        ++count_;
+    }
+
+private:
+    std::mutex                  mutex_;
+    std::uint64_t&              count_;
+    std::vector<std::uint64_t>& ranks_;
+    std::size_t                 limit_;
+};
+
+// Seek to the first rank of a shard by unranking it into the index list and
+// the permutation state.
+
+void seek_single_swap( swap_order const& order
+                     , unsigned char* indices, Number& state
+                     , std::size_t size, std::uint64_t rank) {
+
+    // The permutation state after rank calls to permute() is rank itself.
+    factorial_base::to_factorial_base64(state, rank, size - 1);
+    order.unrank(indices, rank);
+}
+
+// Step to the next index list, returning false at the end of the
+// enumeration.
+
+bool step_single_swap( unsigned char* indices, Number& state
+                     , std::size_t size) {
+
+    auto const swap_indices = permute(state);
+
+    if(state.size() >= size)
+        return false;
+
+    std::swap(indices[std::get<0>(swap_indices)], indices[std::get<1>(swap_indices)]);
+    return true;
+}
+
+}
+
+coverage_report check_coverage( enumeration_order order
+                              , std::size_t       size
+                              , unsigned          threads
+                              , std::size_t       max_reported) {
+
+    assert(size && size <= max_coverage_size);
+
+    coverage_report report;
+    report.size = size;
+
+    std::uint64_t const total = factorial_base::factorial(size);
+
+    visited_bitmap visited(total);
+    offenders      duplicates(report.duplicate_count, report.duplicates, max_reported),
+                   misses(report.miss_count, report.misses, max_reported);
+
+    std::unique_ptr<swap_order> swaps;
+    if(order == enumeration_order::single_swap)
+        swaps.reset(new swap_order(size));
+
+    std::atomic<std::uint64_t> emitted{0};
+    std::atomic<bool>          ended{true};
+
+    factorial_base::parallel_for( std::size_t(total)
+                                , [&](std::size_t first, std::size_t last) {
+
+        if(first == last)
+            return;
+
+        std::uint64_t count = 0;
+
+        auto const visit = [&](std::uint64_t visited_rank) {
+            if(visited.mark(visited_rank))
+                duplicates.add(visited_rank);
+            ++count;
+        };
+
+        if(!swaps) {
+
+            // The strings lexicographic_permutation() yields, of the
+            // characters 0 to size - 1 so each is its own index list.  The
+            // final shard asks for more than remain, which must not be given.
+            string identity(size, '\0');
+            for(std::size_t i = 0; i < size; ++i)
+                identity[i] = char(i);
+
+            auto const wanted = last == total ? last - first + 1 : last - first;
+
+            for(auto const& permuted : lexicographic_range(identity, first, wanted))
+                visit(lexicographic_rank( reinterpret_cast<unsigned char const*>(permuted.data())
+                                        , size));
+
+            if(count != last - first)
+                ended = false;
+
+            emitted += count;
+            return;
+        }
+
+        unsigned char indices[max_coverage_size];
+        Number        state;
+
+        seek_single_swap(*swaps, indices, state, size, first);
+        visit(swaps->rank(indices));
+
+        // Every step within the shard must succeed, and the one after the
+        // final rank must report the end.
+        for(auto r = first + 1; r < last; ++r) {
+
+            if(!step_single_swap(indices, state, size)) {
+                ended = false;
+                break;
+            }
+
+            visit(swaps->rank(indices));
+        }
+
+        if(last == total && step_single_swap(indices, state, size))
+            ended = false;
+
+        emitted += count;
+    }, threads);
+
+    factorial_base::parallel_for( std::size_t(total)
+                                , [&](std::size_t first, std::size_t last) {
+        visited.for_each_clear(first, last, [&](std::uint64_t rank) {
+            misses.add(rank);
+        });
+    }, threads);
+
+    report.visited = emitted;
+    report.ended   = ended;
+
+    std::sort(report.duplicates.begin(), report.duplicates.end());
+    std::sort(report.misses.begin(), report.misses.end());
+
+    return report;
+}
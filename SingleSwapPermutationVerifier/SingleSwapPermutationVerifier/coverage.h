@@ -0,0 +1,62 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutationVerifier.
+//
+// SingleSwapPermutationVerifier is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutationVerifier is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutationVerifier.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+// Exhaustive check that an enumerator visits every permutation exactly once.
+// Each permutation emitted is ranked independently of the enumerator and its
+// rank marked in a bitmap of n! bits, about 780 MB at the largest size.  The
+// rank range is split into one shard per thread, each seeking to its first
+// rank and then running the enumerator, so a defect in the steps, the seek
+// or the end condition shows up as duplicated or missed ranks.
+
+// The enumerations checked.
+enum class enumeration_order {
+    lexicographic,      // lexicographic_range(), as lexicographic_permutation()
+    single_swap         // permute(), as swap_permutation()
+};
+
+// The largest size checked; 13! bits is the largest bitmap allowed.
+std::size_t const max_coverage_size = 13;
+
+// The outcome of a check.  At most a limited number of offending ranks are
+// listed, but all are counted.
+struct coverage_report {
+    std::size_t                size = 0;
+    std::uint64_t              visited = 0,       // permutations emitted
+                               duplicate_count = 0,
+                               miss_count = 0;
+    std::vector<std::uint64_t> duplicates,        // ranks emitted again
+                               misses;            // ranks never emitted
+    bool                       ended = true;      // end condition held
+
+    bool passed() const {
+        return ended && !duplicate_count && !miss_count;
+    }
+};
+
+// Enumerate every permutation of size elements in the given order and report
+// how well the ranks were covered.  The work is split across the given number
+// of threads (0 for all cores).
+coverage_report check_coverage( enumeration_order order
+                              , std::size_t       size
+                              , unsigned          threads = 0
+                              , std::size_t       max_reported = 16);
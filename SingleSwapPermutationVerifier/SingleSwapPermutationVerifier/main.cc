@@ -17,9 +17,13 @@
 // see <http://www.gnu.org/licenses/>.
 
 #include"verifier.h"
+#include"coverage.h"
 using permutation_type = permutation_verifier::permutation_type;
+#include"../../Common_Include/instrumentation.h"
 #include<iostream>
 using std::cout;
+#include<string>
+#include<cstdlib>
 
 // Attempts to verify that strings up to and including a specified length will
 // have their permutations correctly enumerated.
@@ -36,6 +40,8 @@ bool loop_to_size(unsigned size) {
 
     while(previous.size() <= length) {
 
+        INSTRUMENT_STAGE("length " + std::to_string(previous.size() + 1));
+
         // Create the verifier object with the index list of the previous
         // length string.
         permutation_verifier verifier(std::move(previous));
@@ -55,13 +61,67 @@ bool loop_to_size(unsigned size) {
     return true;
 }
 
+// Enumerate every permutation of each length up to that specified in both
+// orders, reporting any rank visited twice or never.
+bool cover_to_size(std::size_t size) {
+
+    bool passed = true;
+
+    for(std::size_t length = 1; length <= size; ++length)
+        for(auto order : { enumeration_order::lexicographic
+                         , enumeration_order::single_swap }) {
+
+            INSTRUMENT_STAGE("coverage " + std::to_string(length));
+
+            auto const report = check_coverage(order, length);
+
+            cout << (order == enumeration_order::lexicographic
+                     ? "Lexicographic" : "Single swap")
+                 << " coverage of length " << length << ": "
+                 << report.visited << " visited, "
+                 << report.duplicate_count << " duplicated, "
+                 << report.miss_count << " missed"
+                 << (report.ended ? "" : ", wrong end") << '\n';
+
+            for(auto rank : report.duplicates)
+                cout << "    duplicate rank " << rank << '\n';
+            for(auto rank : report.misses)
+                cout << "    missed rank " << rank << '\n';
+
+            passed = passed && report.passed();
+        }
+
+    return passed;
+}
+
 // Program Entry Point
-// Invoke the verification loop reporting success when appropriate.
-int main() {
+// Invoke the verification loop reporting success when appropriate.  Given a
+// length argument, the enumerators' coverage is checked through that length
+// instead.
+int main(int argc, char** argv) {
 
     static int unsigned const top = 10000;
 
-    if(loop_to_size(top))
+#if defined(PERMUTATIONS_INSTRUMENT)
+    instrumentation::enable_hardware_counters();
+#endif
+
+    if(2 == argc) {
+
+        auto const size = std::strtoul(argv[1], nullptr, 10);
+
+        if(!size || size > max_coverage_size) {
+            cout << "Coverage length must be 1 thru "
+                 << max_coverage_size << ".\n";
+            return 1;
+        }
+
+        if(cover_to_size(size))
+            cout << "Verified coverage thru permutation of " << size << " elements.\n";
+
+    } else if(loop_to_size(top))
         cout << "Verified thru permutation of " << top << " elements.\n";
+
+    INSTRUMENT_REPORT(std::cerr);
     return 0;
 }
@@ -22,6 +22,8 @@
 #include<algorithm>
 #include<iterator>
 #include<cassert>
+#include"../../Common_Include/small_permutation.h"
+#include"../../Common_Include/permutation_algebra.h"
 
 // Permutation is recursive.  That is, given a final permutation index list for
 // a string of length k-1, one stage of permuting a string of length k can be
@@ -29,19 +31,32 @@
 inline void apply_permutation( std::vector<unsigned>&       inout
                              , std::vector<unsigned> const& in) {
 
-    std::vector<unsigned> work;
+    // Index lists fitting in a vector register are composed with a byte
+    // shuffle.
+    if(inout.size() <= small_permutation::max_size) {
+
+        small_permutation::Shuffle current, prefix;
+        small_permutation::identity(current);
+        small_permutation::identity(prefix);
+
+        std::copy(inout.begin(), inout.end(), current.index);
+        std::copy(in.begin(), in.end(), prefix.index);
+
+        small_permutation::compose(current, current, prefix);
+
+        std::copy(current.index, current.index + inout.size(), inout.begin());
+        return;
+    }
+
+    std::vector<unsigned> work(inout.size());
 
     // Permute the prefix of the k-length index list with the contents of the
     // k-1-length index list.
-    std::transform( in.begin(), in.end()
-                  , std::back_inserter(work)
-                  , [&inout](unsigned i) {
-                        return inout[i];
-                    });
+    permutation_algebra::apply(work.data(), inout.data(), in.data(), in.size());
 
     // The last index of the k-length index list remains unchanged, so copy to
     // the output.
-    work.push_back(inout.back());
+    work.back() = inout.back();
 
     inout = std::move(work);
 }
@@ -0,0 +1,229 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"adjacent_swap.h"
+#include"../../Common_Include/instrumentation.h"
+using frame_arena::generator;
+using std::string;
+#include<algorithm>
+#include<utility>
+#include<cassert>
+
+// Gray code digit j belongs to element size-1-j and has radix size-j, so the
+// largest element's digit is the least significant.
+
+adjacent_counter::adjacent_counter(std::size_t size, std::uint64_t rank)
+: size_(size)
+, digits_(size ? size - 1 : 0, 0U)
+, focus_(digits_.size() + 1)
+, elements_(size)
+, positions_(size)
+, directions_(digits_.size(), 1) {
+
+    for(std::size_t i = 0; i < size; ++i)
+        elements_[i] = positions_[i] = unsigned(i);
+    for(std::size_t j = 0; j < focus_.size(); ++j)
+        focus_[j] = unsigned(j);
+
+    if(rank)
+        seek(rank);
+}
+
+// Split the rank into the counter digits the Gray code reflects, then
+// reflect those digits below an odd value of the digits above.
+void adjacent_counter::digits_of( std::uint64_t rank, std::size_t size
+                                , unsigned* digits, bool* reflected) {
+
+    auto const count = size ? size - 1 : 0;
+
+    for(std::size_t j = 0; j < count; ++j) {
+        digits[j] = unsigned(rank % (size - j));
+        rank /= size - j;
+    }
+
+    assert(!rank);
+
+    bool odd = false;
+
+    for(auto j = count; j--; ) {
+        auto const radix = unsigned(size - j),
+                   value = digits[j];
+        reflected[j] = odd;
+        if(odd)
+            digits[j] = radix - 1 - value;
+        odd = ((value + (radix & 1 ? odd : 0)) & 1) != 0;
+    }
+}
+
+// Move to the given rank.
+void adjacent_counter::seek(std::uint64_t rank) {
+
+    assert(size_ <= max_rank64_size);
+
+    unsigned counter[max_rank64_size];
+    bool     reflected[max_rank64_size];
+
+    digits_of(rank, size_, digits_.data(), reflected);
+
+    // Recover the counter digits; a digit at its maximum is passive, its
+    // sweep complete and its direction already reversed.
+    for(std::size_t j = 0; j < digits_.size(); ++j) {
+        auto const radix = unsigned(size_ - j);
+        counter[j] = reflected[j] ? radix - 1 - digits_[j] : digits_[j];
+        bool const passive = counter[j] == radix - 1;
+        directions_[j] = reflected[j] != passive ? -1 : 1;
+    }
+
+    // The first digit of each run of passive digits points past the run.
+    for(std::size_t j = 0; j < focus_.size(); ++j)
+        focus_[j] = unsigned(j);
+
+    for(std::size_t j = 0; j < digits_.size(); ) {
+
+        if(counter[j] != size_ - j - 1) {
+            ++j;
+            continue;
+        }
+
+        auto k = j;
+        while(k < digits_.size() && counter[k] == size_ - k - 1)
+            ++k;
+
+        focus_[j] = unsigned(k);
+        j = k;
+    }
+
+    // Insert the elements in increasing order, each to the left of the
+    // number of smaller elements its digit counts.
+    elements_.clear();
+    for(std::size_t e = 0; e < size_; ++e) {
+        auto const smaller_right = e ? digits_[size_ - 1 - e] : 0U;
+        elements_.insert(elements_.end() - smaller_right, unsigned(e));
+    }
+
+    for(std::size_t i = 0; i < size_; ++i)
+        positions_[elements_[i]] = unsigned(i);
+
+    done_ = false;
+}
+
+// Return the positions exchanged to reach the next permutation.
+swap_indices_type permute(adjacent_counter& counter) {
+
+    auto const j = counter.focus_[0];
+    counter.focus_[0] = 0;
+
+    if(j == counter.digits_.size()) {
+        counter.done_ = true;
+        return swap_indices_type{ 0, 0 };
+    }
+
+    auto const direction = counter.directions_[j];
+    auto const digit = counter.digits_[j] += direction;
+
+    // Move the digit's element one position, left while its digit rises.
+    auto const element = unsigned(counter.size_ - 1 - j),
+               from    = counter.positions_[element],
+               to      = unsigned(int(from) - direction),
+               other   = counter.elements_[to];
+
+    counter.elements_[from]   = other;
+    counter.elements_[to]     = element;
+    counter.positions_[other]   = from;
+    counter.positions_[element] = to;
+
+    // At either end of its range the digit reverses and becomes passive.
+    if(!digit || digit == counter.size_ - 1 - j) {
+        counter.directions_[j] = -direction;
+        counter.focus_[j]      = counter.focus_[j + 1];
+        counter.focus_[j + 1]  = j + 1;
+    }
+
+    return swap_indices_type{ std::min(from, to), std::max(from, to) };
+}
+
+// Return the rank of the index list provided.
+std::uint64_t adjacent_counter::rank(unsigned char const* in, std::size_t size) {
+
+    assert(size <= max_rank64_size);
+
+    // Count the smaller elements right of each.
+    unsigned digits[max_rank64_size] = {};
+
+    for(std::size_t i = 0; i < size; ++i)
+        for(std::size_t k = i + 1; k < size; ++k)
+            if(in[k] < in[i])
+                ++digits[size - 1 - in[i]];
+
+    // Undo the reflections, most significant digit first.
+    std::uint64_t result = 0;
+    bool odd = false;
+
+    for(auto j = size ? size - 1 : 0; j--; ) {
+        auto const radix = unsigned(size - j),
+                   value = odd ? radix - 1 - digits[j] : digits[j];
+        result = result * radix + value;
+        odd = ((value + (radix & 1 ? odd : 0)) & 1) != 0;
+    }
+
+    return result;
+}
+
+// Compute the index list of the rank provided.
+void adjacent_counter::unrank(unsigned char* out, std::size_t size, std::uint64_t rank) {
+
+    assert(size <= max_rank64_size);
+
+    unsigned digits[max_rank64_size];
+    bool     reflected[max_rank64_size];
+
+    digits_of(rank, size, digits, reflected);
+
+    // Insert the elements in increasing order, as seek() does.
+    for(std::size_t e = 0; e < size; ++e) {
+        auto const at = e - (e ? digits[size - 1 - e] : 0U);
+        std::copy_backward(out + at, out + e, out + e + 1);
+        out[at] = (unsigned char)e;
+    }
+}
+
+// Yields the permutations of a string in adjacent transposition order.
+generator<string> iterate_adjacent(string const& in) {
+
+    string result{in};
+    adjacent_counter counter(in.size());
+
+    INSTRUMENT_COUNT(permutations, 1);
+    co_yield result;
+    INSTRUMENT_COUNT(resumes, 1);
+
+    for(;;) {
+
+        auto const swap_indices = permute(counter);
+
+        if(counter.done())
+            break;
+
+        std::swap( result[std::get<0>(swap_indices)]
+                 , result[std::get<1>(swap_indices)]);
+
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield result;
+        INSTRUMENT_COUNT(resumes, 1);
+    }
+}
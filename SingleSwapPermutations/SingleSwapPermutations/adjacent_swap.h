@@ -0,0 +1,91 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"permutation_from_swap.h"
+#include"../../Common_Include/frame_arena.h"
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+// The permutation state of the Steinhaus-Johnson-Trotter order, in which
+// every step exchanges two adjacent positions.
+//
+// Element e's digit counts the smaller elements to its right, from 0 thru e.
+// The order is the reflected mixed-radix Gray code over those digits, the
+// largest element's fastest: each step moves one element a single position
+// past a smaller one, the direction reversing each time it reaches an end.
+// Focus pointers (Knuth, Algorithm 7.2.1.1H) pick the digit to change, so
+// a step takes constant time with no loop (Even's speedup).
+//
+// The state is ranked by converting the Gray code back to the counter it
+// reflects, so a state may be positioned at any rank to shard the
+// enumeration.
+class adjacent_counter {
+public:
+
+    // The largest permutation whose rank fits in 64 bits.
+    static std::size_t const max_rank64_size = 20;
+
+    // Position the state at the given rank of a size element enumeration.
+    explicit adjacent_counter(std::size_t size, std::uint64_t rank = 0);
+
+    // Move to the given rank.  The size must be at most max_rank64_size.
+    void seek(std::uint64_t rank);
+
+    std::size_t size() const { return size_; }
+
+    // Test that the enumeration has passed its final permutation.
+    bool done() const { return done_; }
+
+    // The current index list, whose element i holds the original position of
+    // the element now at position i.
+    std::vector<unsigned> const& permutation() const { return elements_; }
+
+    // Return the positions exchanged to reach the next permutation, the lower
+    // first.  Once the final permutation has been reached, sets done().
+    friend swap_indices_type permute(adjacent_counter& counter);
+
+    // Return the rank of the index list provided, which must hold size
+    // elements with size no greater than max_rank64_size.
+    static std::uint64_t rank(unsigned char const* in, std::size_t size);
+
+    // Compute the index list of the rank provided.
+    static void unrank(unsigned char* out, std::size_t size, std::uint64_t rank);
+
+private:
+
+    // Set the Gray code digits of a rank, least significant first, and
+    // return each digit's reflection.
+    static void digits_of( std::uint64_t rank, std::size_t size
+                         , unsigned* digits, bool* reflected);
+
+    std::size_t            size_;
+    std::vector<unsigned>  digits_,         // Gray code digit of each element
+                           focus_,          // focus pointers
+                           elements_,       // the index list
+                           positions_;      // position of each element
+    std::vector<int>       directions_;     // +1 moves an element left
+    bool                   done_ { false };
+};
+
+// Yields the permutations of a string in the order above, starting with the
+// string itself.
+frame_arena::generator<std::string> iterate_adjacent(std::string const& in);
@@ -17,47 +17,134 @@
 // see <http://www.gnu.org/licenses/>.
 
 #include"permutation_from_swap.h"
+#include"swap_table.h"
+#include"swap_delta.h"
+#include"../../Common_Include/instrumentation.h"
 using factorial_base::Number;
 #include<iostream>
 using std::cout;
 #include<algorithm>
+#include<cmath>
 #include<iterator>
-#include<experimental\generator>
+#include"../../Common_Include/frame_arena.h"
 #include<string>
 using std::string;
+#include<vector>
+#include<random>
+#include<chrono>
 
-// The yielding iterating function.
-// Yields the next permutation of a string.
-// Completes when the size of the permutation state is less than the
-// string size.
-auto iterate(string const& in) {
-    string result{in};
-    auto const string_size = in.size();
+// Compare evaluating every tour of a set of cities, the permutations of
+// their visiting order, by recomputing each tour's length and by updating it
+// from the swap leading to it.
+int benchmark() {
 
-    // Initialize the permutation state.
-    Number permutation_counter{0};
+    std::size_t const cities = 12;
 
-    for(;;) {
+    // Random symmetric distances.
+    std::mt19937 random(12);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::vector<double> x(cities), y(cities), distance(cities * cities);
 
-        // Get the string positions to swap.
-        auto swap_indices = permute(permutation_counter);
+    for(std::size_t i = 0; i < cities; ++i) {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random);
+    }
+
+    for(std::size_t i = 0; i < cities; ++i)
+        for(std::size_t j = 0; j < cities; ++j)
+            distance[i * cities + j] = std::hypot(x[i] - x[j], y[i] - y[j]);
+
+    auto const length = [&](std::vector<unsigned> const& tour) {
+        double total = 0;
+        for(std::size_t i = 0; i < cities; ++i)
+            total += distance[tour[i] * cities + tour[(i + 1) % cities]];
+        return total;
+    };
+
+    using clock = std::chrono::steady_clock;
+    auto const seconds = [](clock::time_point start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    std::vector<unsigned> tour(cities);
+    for(std::size_t i = 0; i < cities; ++i)
+        tour[i] = unsigned(i);
 
-        // Test loop end condition.
-        if(permutation_counter.size() >= string_size)
-            break;
+    // Full recomputation after every swap.
+    auto start = clock::now();
+    double best_full = length(tour);
 
-        std::swap( result[std::get<0>(swap_indices)]
-                 , result[std::get<1>(swap_indices)]);
+    for_each_swap(factorial_base::span<unsigned>(tour),
+        [&](swap_step<unsigned> const&) {
+            best_full = std::min(best_full, length(tour));
+        });
 
-        co_yield result;
+    auto const full = seconds(start);
+
+    // Incremental update: only the edges leaving the two swapped positions
+    // and the positions before them change.  The tour before the swap is
+    // read by exchanging the two positions back.
+    std::vector<std::size_t> previous(cities), next(cities);
+    for(std::size_t i = 0; i < cities; ++i) {
+        tour[i]     = unsigned(i);
+        previous[i] = (i + cities - 1) % cities;
+        next[i]     = (i + 1) % cities;
     }
+
+    start = clock::now();
+    double current = length(tour),
+           best_delta = current;
+
+    for_each_swap(factorial_base::span<unsigned>(tour),
+        [&](swap_step<unsigned> const& step) {
+
+            auto const i = step.first,
+                       j = step.second;
+
+            auto const before = [&](std::size_t p) {
+                return p == i ? step.second_element
+                     : p == j ? step.first_element
+                     :          tour[p];
+            };
+
+            auto const change = [&](std::size_t p) {
+                return distance[tour[p] * cities + tour[next[p]]]
+                     - distance[before(p) * cities + before(next[p])];
+            };
+
+            // Count an edge shared by both positions once.
+            double total = change(i) + change(j);
+            if(previous[j] != i)
+                total += change(previous[j]);
+            if(previous[i] != j)
+                total += change(previous[i]);
+
+            current += total;
+            best_delta = std::min(best_delta, current);
+        });
+
+    auto const delta = seconds(start);
+
+    cout << "Shortest of " << factorial_base::factorial(cities) << " tours of "
+         << cities << " cities: " << best_full << " (full), "
+         << best_delta << " (incremental)\n"
+         << "Full recomputation: " << full << " s\n"
+         << "Incremental update: " << delta << " s ("
+         << full / delta << "x)\n";
+
+    return 0;
 }
 
-int main() {
+int main(int argc, char** argv) {
+
+    if(argc > 1 && string(argv[1]) == "benchmark")
+        return benchmark();
 
     string to_permute("abcdefg");
 
-    for(auto& permutation : iterate(to_permute)) {
+    // The string's length is known at compile time, so its swap table is
+    // walked rather than incrementing the permutation state.
+    for(auto& permutation : iterate_fixed<7>(to_permute)) {
 
         std::copy(permutation.begin(), permutation.end(),
                   std::ostream_iterator<char>(cout, ""));
@@ -65,5 +152,6 @@ int main() {
         cout << '\n';
     }
 
+    INSTRUMENT_REPORT(std::cerr);
     return 0;
 }
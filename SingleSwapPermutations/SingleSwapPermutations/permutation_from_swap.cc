@@ -20,21 +20,6 @@
 using Number = factorial_base::Number;
 using value_type = Number::value_type;
 
-// Returns a tuple of string positions to be swapped.
-// The first argument is the permutation state.
-// The second argument is a selector indicating a prefix of the string.
-inline swap_indices_type number_to_swap_indices( Number const& number
-                                               , unsigned prefix_selector) {
-
-    // Return the tuple with the index to the end of the string as the final
-    // element and with a first element as the index to
-    // - the first string element, if the selector is odd -OR-
-    // - some character indexed by the prefix selector into the permutation
-    //   state (1-based)
-    return { (prefix_selector & 1) ? 0 : number[prefix_selector] - 1
-           , prefix_selector + 1 };
-}
-
 // Returns a tuple of string positions to be swapped.
 // The argument is the permutation state.
 // Increments the permutation state from which the swap indices are extracted.
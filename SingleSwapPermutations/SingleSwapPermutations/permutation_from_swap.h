@@ -23,6 +23,29 @@
 using swap_indices_type = std::tuple< factorial_base::Number::value_type
                                     , factorial_base::Number::value_type >;
 
+// Returns a tuple of string positions to be swapped.
+// The first argument is a selector indicating a prefix of the string.
+// The second argument is the permutation state's digit at the selector.
+constexpr swap_indices_type digit_to_swap_indices( unsigned prefix_selector
+                                                 , unsigned digit) {
+
+    // Return the tuple with the index to the end of the string as the final
+    // element and with a first element as the index to
+    // - the first string element, if the selector is odd -OR-
+    // - some character indexed by the prefix selector into the permutation
+    //   state (1-based)
+    return swap_indices_type{ (prefix_selector & 1) ? 0 : digit - 1
+                            , prefix_selector + 1 };
+}
+
+// Returns a tuple of string positions to be swapped.
+// The first argument is the permutation state.
+// The second argument is a selector indicating a prefix of the string.
+inline swap_indices_type number_to_swap_indices( factorial_base::Number const& number
+                                               , unsigned prefix_selector) {
+    return digit_to_swap_indices(prefix_selector, number[prefix_selector]);
+}
+
 // Return a tuple containing the indices of a string to swap with the argument
 // being the current state of the permutations of the string.
 swap_indices_type permute(factorial_base::Number& permutation_counter);
@@ -0,0 +1,56 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"swap_batch.h"
+#include<cstring>
+#include<cstdint>
+#if defined(_M_X64) || defined(__SSE2__)
+#   include<emmintrin.h>
+#   define SWAP_BATCH_SSE2 1
+#endif
+
+// Exchange two non-overlapping byte ranges of equal length.
+void swap_rows(void* first, void* second, std::size_t bytes) {
+
+    auto a = static_cast<unsigned char*>(first),
+         b = static_cast<unsigned char*>(second);
+
+#if defined(SWAP_BATCH_SSE2)
+    for(; bytes >= 16; bytes -= 16, a += 16, b += 16) {
+        __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a)),
+                      y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(a), y);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b), x);
+    }
+#endif
+
+    // Remaining tail, a word at a time then byte by byte.
+    for(; bytes >= sizeof(std::uint64_t); bytes -= 8, a += 8, b += 8) {
+        std::uint64_t x, y;
+        std::memcpy(&x, a, 8);
+        std::memcpy(&y, b, 8);
+        std::memcpy(a, &y, 8);
+        std::memcpy(b, &x, 8);
+    }
+
+    for(; bytes; --bytes, ++a, ++b) {
+        unsigned char const x = *a;
+        *a = *b;
+        *b = x;
+    }
+}
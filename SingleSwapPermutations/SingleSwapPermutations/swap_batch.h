@@ -0,0 +1,112 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"permutation_from_swap.h"
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<type_traits>
+#include<cstddef>
+#include<cassert>
+
+// Exchange two non-overlapping byte ranges of equal length, 16 bytes at a
+// time where SSE2 is available.
+void swap_rows(void* first, void* second, std::size_t bytes);
+
+// Enumerates the permutations of many sequences of equal length in lockstep.
+// The order permute() produces depends only on the length, so one permutation
+// state drives every sequence.  The sequences are stored position major
+// (structure of arrays): row p holds the element at position p of every
+// sequence, so each swap exchanges two contiguous rows.
+template<typename T>
+class swap_batch {
+public:
+
+    // Transpose the sequences, which must all have the same length, into
+    // rows.
+    template<typename Sequence_>
+    explicit swap_batch(std::vector<Sequence_> const& sequences)
+    : count_(sequences.size())
+    , size_(sequences.empty() ? 0 : sequences.front().size())
+    , rows_(count_ * size_) {
+        for(std::size_t s = 0; s < count_; ++s) {
+            assert(sequences[s].size() == size_);
+            for(std::size_t p = 0; p < size_; ++p)
+                rows_[p * count_ + s] = sequences[s][p];
+        }
+    }
+
+    // Advance every sequence to its next permutation.  Returns false,
+    // changing nothing, once every permutation has been visited.
+    bool next() {
+
+        auto const swap_indices = permute(permutation_counter_);
+
+        // Test end condition.
+        if(permutation_counter_.size() >= size_)
+            return false;
+
+        last_swap_ = swap_indices;
+
+        T* const first  = row(std::get<0>(swap_indices));
+        T* const second = row(std::get<1>(swap_indices));
+
+        exchange(first, second, std::is_trivially_copyable<T>());
+
+        return true;
+    }
+
+    std::size_t count() const { return count_; }     // number of sequences
+    std::size_t size() const { return size_; }       // length of each
+
+    // The elements at position p of every sequence.
+    T* row(std::size_t p) { return rows_.data() + p * count_; }
+    T const* row(std::size_t p) const { return rows_.data() + p * count_; }
+
+    // The element at position p of sequence s.
+    T const& at(std::size_t s, std::size_t p) const { return rows_[p * count_ + s]; }
+
+    // Gather sequence s in its current permutation.
+    template<typename Sequence_>
+    void sequence(Sequence_& out, std::size_t s) const {
+        out.resize(size_);
+        for(std::size_t p = 0; p < size_; ++p)
+            out[p] = at(s, p);
+    }
+
+    // The positions exchanged by the last call to next().
+    swap_indices_type const& last_swap() const { return last_swap_; }
+
+private:
+
+    void exchange(T* first, T* second, std::true_type) {
+        swap_rows(first, second, count_ * sizeof(T));
+    }
+
+    void exchange(T* first, T* second, std::false_type) {
+        std::swap_ranges(first, first + count_, second);
+    }
+
+    std::size_t             count_,
+                            size_;
+    std::vector<T>          rows_;
+    factorial_base::Number  permutation_counter_ { 0 };
+    swap_indices_type       last_swap_;
+};
@@ -0,0 +1,104 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"permutation_from_swap.h"
+#include"adjacent_swap.h"
+#include"../../Common_Include/span.h"
+#include<cstddef>
+#include<cstdint>
+#include<utility>
+
+// Consecutive permutations of a single-swap enumeration differ in two
+// positions, so an objective over the permutation can often be updated in
+// constant time from the two positions and elements exchanged instead of
+// being recomputed.  The functions below permute a buffer in place and report
+// each step to a visitor after the buffer has been updated.
+
+// One step of the enumeration, seen after the exchange.
+template<typename T>
+struct swap_step {
+    std::size_t first,              // the positions exchanged, first lower
+                second;
+    T const&    first_element;      // the element now at first
+    T const&    second_element;     // the element now at second
+};
+
+// Run the enumeration whose next swap is produced by next(i, j), which
+// returns false after the last.
+template<typename T, typename Next_, typename Visit_>
+std::uint64_t for_each_step( factorial_base::span<T> elements
+                           , Next_                   next
+                           , Visit_                  visit) {
+
+    std::uint64_t steps = 0;
+
+    for(std::size_t i, j; next(i, j); ++steps) {
+        using std::swap;
+        swap(elements[i], elements[j]);
+        visit(swap_step<T>{ i, j, elements[i], elements[j] });
+    }
+
+    return steps;
+}
+
+// Permute the elements in the order permute() enumerates, invoking
+// visit(swap_step<T>) after each swap.  The elements are left in their final
+// permutation.  Returns the number of steps, n! - 1.
+template<typename T, typename Visit_>
+std::uint64_t for_each_swap(factorial_base::span<T> elements, Visit_ visit) {
+
+    factorial_base::Number permutation_counter{0};
+    auto const size = elements.size();
+
+    return for_each_step(elements,
+        [&permutation_counter, size](std::size_t& i, std::size_t& j) {
+
+            auto const swap_indices = permute(permutation_counter);
+
+            // Test end condition.
+            if(permutation_counter.size() >= size)
+                return false;
+
+            i = std::get<0>(swap_indices);
+            j = std::get<1>(swap_indices);
+            return true;
+        }, visit);
+}
+
+// As for_each_swap(), in adjacent transposition order, so that second is
+// always first + 1.
+template<typename T, typename Visit_>
+std::uint64_t for_each_adjacent_swap(factorial_base::span<T> elements, Visit_ visit) {
+
+    adjacent_counter counter(elements.size());
+
+    return for_each_step(elements,
+        [&counter](std::size_t& i, std::size_t& j) {
+
+            auto const swap_indices = permute(counter);
+
+            if(counter.done())
+                return false;
+
+            i = std::get<0>(swap_indices);
+            j = std::get<1>(swap_indices);
+            return true;
+        }, visit);
+}
@@ -0,0 +1,139 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"permutation_from_swap.h"
+#include"../../Common_Include/span.h"
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+#include<utility>
+
+// Enumerates the permutations of a span of any element type in the order
+// permute() does, without copying any element.  Alongside the elements the
+// engine keeps the index permutation, whose element i holds the original
+// position of the element now at position i.  Elements that are expensive to
+// exchange may be left where they are (in_place false) and read through the
+// index permutation instead.
+template< typename T
+        , typename Index_ = std::uint32_t
+        , bool     Direct_ = factorial_base::is_directly_permuted<T>::value >
+class swap_engine {
+public:
+    using element_span = factorial_base::span<T>;
+    using index_span   = factorial_base::span<Index_ const>;
+
+    explicit swap_engine(element_span elements, bool in_place = true)
+    : elements_(elements)
+    , in_place_(in_place)
+    , indices_(elements.size()) {
+        for(std::size_t i = 0; i < indices_.size(); ++i)
+            indices_[i] = Index_(i);
+    }
+
+    // Advance to the next permutation.  Returns false once every permutation
+    // has been visited, leaving the elements as they were but the counter
+    // past the last permutation.
+    bool next() {
+
+        auto const swap_indices = permute(permutation_counter_);
+
+        // Test end condition.
+        if(permutation_counter_.size() >= elements_.size())
+            return false;
+
+        last_swap_ = swap_indices;
+
+        auto const i = std::get<0>(swap_indices),
+                   j = std::get<1>(swap_indices);
+
+        std::swap(indices_[i], indices_[j]);
+
+        if(in_place_) {
+            using std::swap;
+            swap(elements_[i], elements_[j]);
+        }
+
+        return true;
+    }
+
+    std::size_t size() const { return elements_.size(); }
+
+    // The element at position i of the current permutation.
+    T& operator[](std::size_t i) const {
+        return elements_[in_place_ ? i : indices_[i]];
+    }
+
+    // The current index permutation.
+    index_span indices() const { return index_span(indices_.data(), indices_.size()); }
+
+    // The positions exchanged by the last call to next().
+    swap_indices_type const& last_swap() const { return last_swap_; }
+
+private:
+    element_span            elements_;
+    bool                    in_place_;
+    std::vector<Index_>     indices_;
+    factorial_base::Number  permutation_counter_ { 0 };
+    swap_indices_type       last_swap_;
+};
+
+// Small trivially copyable elements, such as the integers of an index array,
+// are exchanged directly and no separate index permutation is kept.
+template<typename T, typename Index_>
+class swap_engine<T, Index_, true> {
+public:
+    using element_span = factorial_base::span<T>;
+
+    // in_place is accepted as the general engine's is, and ignored.
+    explicit swap_engine(element_span elements, bool /*in_place*/ = true)
+    : elements_(elements) {
+    }
+
+    // Advance to the next permutation.  Returns false once every permutation
+    // has been visited, leaving the elements as they were but the counter
+    // past the last permutation.
+    bool next() {
+
+        auto const swap_indices = permute(permutation_counter_);
+
+        // Test end condition.
+        if(permutation_counter_.size() >= elements_.size())
+            return false;
+
+        last_swap_ = swap_indices;
+        std::swap( elements_[std::get<0>(swap_indices)]
+                 , elements_[std::get<1>(swap_indices)]);
+
+        return true;
+    }
+
+    std::size_t size() const { return elements_.size(); }
+
+    // The element at position i of the current permutation.
+    T& operator[](std::size_t i) const { return elements_[i]; }
+
+    // The positions exchanged by the last call to next().
+    swap_indices_type const& last_swap() const { return last_swap_; }
+
+private:
+    element_span            elements_;
+    factorial_base::Number  permutation_counter_ { 0 };
+    swap_indices_type       last_swap_;
+};
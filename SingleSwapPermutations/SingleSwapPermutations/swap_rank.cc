@@ -0,0 +1,182 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"swap_rank.h"
+#include"permutation_from_swap.h"
+#include"../../Common_Include/parallel_for.h"
+using factorial_base::Number;
+#include<algorithm>
+#include<utility>
+#include<cassert>
+
+// Index of the first ending of the m element prefix.
+inline std::size_t endings_offset(std::size_t m) {
+    return m * (m - 1) / 2;
+}
+
+// Tabulate the initial arrangement of every block of every prefix length.
+swap_order::swap_order(std::size_t size)
+: size_(size)
+, offsets_(size + 1, 0) {
+
+    std::size_t total = 0;
+    for(std::size_t m = 0; m <= size; ++m) {
+        offsets_[m] = total;
+        total += m * m;
+    }
+
+    blocks_.resize(total);
+    inverses_.resize(total);
+    endings_.resize(endings_offset(size + 1));
+
+    if(size < 1)
+        return;
+
+    blocks_[offsets_[1]] = inverses_[offsets_[1]] = 0;
+
+    // The arrangement left by a complete enumeration of the m-1 element
+    // prefix, starting from the identity.
+    permutation_type full{0};
+
+    for(std::size_t m = 2; m <= size; ++m) {
+
+        permutation_type arrangement(m);
+        for(unsigned i = 0; i < m; ++i)
+            arrangement[i] = i;
+
+        for(unsigned d = 0; d < m; ++d) {
+
+            auto const first = offsets_[m] + d * m;
+            std::copy(arrangement.begin(), arrangement.end(), blocks_.begin() + first);
+            for(unsigned i = 0; i < m; ++i)
+                inverses_[first + arrangement[i]] = i;
+            endings_[endings_offset(m) + arrangement[m - 1]] = d;
+
+            // Run the enumeration of the m-1 element prefix.
+            permutation_type prefix(arrangement.begin(), arrangement.end() - 1);
+            for(std::size_t i = 0; i + 1 < m; ++i)
+                arrangement[i] = prefix[full[i]];
+
+            // Swap into position m-1 as permute() does when the digit at
+            // m-2 becomes d+1.
+            if(d + 1 < m) {
+                auto const indices = digit_to_swap_indices(unsigned(m - 2), d + 1);
+                std::swap( arrangement[std::get<0>(indices)]
+                         , arrangement[std::get<1>(indices)]);
+            }
+        }
+
+        full = std::move(arrangement);
+    }
+}
+
+// Find the block of the m element prefix from its final element, and express
+// the first m-1 positions relative to that block's initial arrangement.
+template<typename Index_>
+unsigned swap_order::descend(Index_* inout, std::size_t m) const {
+
+    assert(inout[m - 1] < m);
+
+    auto const d = endings_[endings_offset(m) + inout[m - 1]];
+    auto const inv = inverse(m, d);
+
+    for(std::size_t i = 0; i + 1 < m; ++i)
+        inout[i] = Index_(inv[inout[i]]);
+
+    return d;
+}
+
+// Compute the permutation state leading to the index list provided.
+void swap_order::rank(Number& out, permutation_type const& in) const {
+
+    assert(in.size() == size_);
+
+    out.assign(size_ ? size_ - 1 : 0, 0U);
+
+    permutation_type work{in};
+    for(auto m = size_; m >= 2; --m)
+        out[m - 2] = descend(work.data(), m);
+}
+
+// Return the rank of the index list provided, accumulating the digits by
+// Horner's Rule as they are found, most significant first.
+std::uint64_t swap_order::rank(unsigned char const* in) const {
+
+    assert(size_ <= max_rank64_size);
+
+    unsigned char work[max_rank64_size];
+    std::copy(in, in + size_, work);
+
+    std::uint64_t rank = 0;
+    for(auto m = size_; m >= 2; --m)
+        rank = rank * m + descend(work, m);
+
+    return rank;
+}
+
+// Compute the index list the permutation state provided leads to by
+// composing the initial arrangements of its blocks, least significant first.
+void swap_order::unrank(permutation_type& out, Number const& state) const {
+
+    assert(state.size() + 1 >= size_);
+
+    out.assign(size_, 0U);
+
+    for(std::size_t m = 2; m <= size_; ++m) {
+        auto const arrangement = block(m, state[m - 2]);
+        for(std::size_t i = 0; i + 1 < m; ++i)
+            out[i] = arrangement[out[i]];
+        out[m - 1] = arrangement[m - 1];
+    }
+}
+
+// Compute the index list of the rank provided.
+void swap_order::unrank(unsigned char* out, std::uint64_t rank) const {
+
+    assert(size_ <= max_rank64_size);
+
+    if(size_)
+        out[0] = 0;
+
+    for(std::size_t m = 2; m <= size_; ++m) {
+        auto const arrangement = block(m, unsigned(rank % m));
+        rank /= m;
+        for(std::size_t i = 0; i + 1 < m; ++i)
+            out[i] = (unsigned char)arrangement[out[i]];
+        out[m - 1] = (unsigned char)arrangement[m - 1];
+    }
+
+    assert(!rank);
+}
+
+// Rank count index lists stored consecutively, across threads.
+void swap_rank_batch( swap_order const&    order
+                    , unsigned char const* permutations
+                    , std::size_t          count
+                    , std::uint64_t*       ranks
+                    , unsigned             threads) {
+
+    auto const size = order.size();
+
+    factorial_base::parallel_for(count,
+        [&order, size, permutations, ranks](std::size_t first, std::size_t last) {
+            for(auto i = first; i < last; ++i)
+                ranks[i] = order.rank(permutations + i * size);
+        },
+        threads);
+}
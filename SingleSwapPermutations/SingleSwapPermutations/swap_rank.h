@@ -0,0 +1,94 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"../../Common_Include/factorial_base_common.h"
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+// Ranks and unranks the permutations of an n element string in the order
+// permute() enumerates them.  Permutations are index lists, where element i
+// holds the position in the original string of the character at position i.
+// The rank of a permutation is the number of swaps leading to it, so the
+// original string has rank 0, and its permutation state is the counter
+// permute() leaves behind after that many calls.
+//
+// The swaps that touch position m-1 partition the enumeration of an m element
+// prefix into m blocks.  Within block d the element at position m-1 is fixed,
+// and the lower positions run through a complete enumeration of the m-1
+// element prefix starting from the block's initial arrangement.  Those
+// arrangements are tabulated for every prefix length on construction, in
+// O(n^3) time and space, after which ranking and unranking take O(n^2).
+class swap_order {
+public:
+    using permutation_type = std::vector<unsigned>;
+
+    // The largest permutation whose rank fits in 64 bits.
+    static std::size_t const max_rank64_size = 20;
+
+    explicit swap_order(std::size_t size);
+
+    std::size_t size() const { return size_; }
+
+    // Compute the permutation state leading to the index list provided.
+    void rank(factorial_base::Number& out, permutation_type const& in) const;
+
+    // Return the rank of the index list provided, which must hold size()
+    // elements with size() no greater than max_rank64_size.
+    std::uint64_t rank(unsigned char const* in) const;
+
+    // Compute the index list the permutation state provided leads to.
+    void unrank(permutation_type& out, factorial_base::Number const& state) const;
+
+    // Compute the index list of the rank provided.
+    void unrank(unsigned char* out, std::uint64_t rank) const;
+
+    // Return the initial arrangement of block d of the m element prefix, that
+    // unranking composes for a digit d at m-2.
+    unsigned const* block(std::size_t m, unsigned d) const {
+        return &blocks_[offsets_[m] + d * m];
+    }
+
+private:
+
+    // Apply the inverse of block d's initial arrangement of the m element
+    // prefix to the indices of its first m-1 positions.
+    template<typename Index_>
+    unsigned descend(Index_* inout, std::size_t m) const;
+
+    unsigned const* inverse(std::size_t m, unsigned d) const {
+        return &inverses_[offsets_[m] + d * m];
+    }
+
+    std::size_t              size_;
+    std::vector<std::size_t> offsets_;      // table start of each prefix length
+    std::vector<unsigned>    blocks_,       // initial arrangement of each block
+                             inverses_,     // inverse of each of the above
+                             endings_;      // block holding each final element
+};
+
+// Rank count index lists, each of order.size() elements, stored
+// consecutively.  The work is split across the given number of threads
+// (0 for all cores).
+void swap_rank_batch( swap_order const&    order
+                    , unsigned char const* permutations
+                    , std::size_t          count
+                    , std::uint64_t*       ranks
+                    , unsigned             threads = 0);
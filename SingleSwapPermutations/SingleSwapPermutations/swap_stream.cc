@@ -0,0 +1,209 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"swap_stream.h"
+#include"permutation_from_swap.h"
+#include"../../Common_Include/factorial_base_conversions.h"
+#include"../../Common_Include/little_endian.h"
+using factorial_base::Number;
+using std::string;
+#include<fstream>
+#include<vector>
+#include<utility>
+
+namespace swap_stream {
+
+using little_endian::put;
+using little_endian::get;
+
+inline void put_varint(std::ostream& out, std::uint64_t value, std::uint64_t& offset) {
+    do {
+        auto const byte = std::uint8_t(value & 0x7F);
+        value >>= 7;
+        out.put(char(value ? byte | 0x80 : byte));
+        ++offset;
+    } while(value);
+}
+
+void put_header(std::ostream& out, header const& h) {
+    put(out, h.magic, 4);
+    put(out, h.version, 2);
+    put(out, h.size, 2);
+    put(out, h.first, 8);
+    put(out, h.count, 8);
+    put(out, h.seek_interval, 8);
+    put(out, h.seek_count, 8);
+    put(out, h.data_offset, 8);
+    put(out, h.seek_offset, 8);
+}
+
+header get_header(std::uint8_t const* in) {
+    header h;
+    h.magic         = std::uint32_t(get(in, 4));
+    h.version       = std::uint16_t(get(in + 4, 2));
+    h.size          = std::uint16_t(get(in + 6, 2));
+    h.first         = get(in + 8, 8);
+    h.count         = get(in + 16, 8);
+    h.seek_interval = get(in + 24, 8);
+    h.seek_count    = get(in + 32, 8);
+    h.data_offset   = get(in + 40, 8);
+    h.seek_offset   = get(in + 48, 8);
+    return h;
+}
+
+// Write the count swaps leading away from the permutation of rank first.
+bool write( string const&  path
+          , std::size_t    size
+          , std::uint64_t  first
+          , std::uint64_t  count
+          , std::uint64_t  seek_interval) {
+
+    if(size < 2 || size > 0xFFFF || !seek_interval)
+        return false;
+
+    // The final rank must still be a permutation of size elements.
+    if(size <= 20 && first + count >= factorial_base::factorial(size))
+        return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if(!out)
+        return false;
+
+    header h{ magic, version, std::uint16_t(size), first, count
+            , seek_interval, 0, header_bytes, 0 };
+
+    // Reserve the header's space; it is rewritten once the offsets are known.
+    put_header(out, h);
+
+    // Position the permutation state at the first rank.
+    Number permutation_counter;
+    factorial_base::to_factorial_base64(permutation_counter, first, size - 1);
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> seeks;
+    std::uint64_t offset = 0;
+
+    for(std::uint64_t step = 0; step < count; ++step) {
+
+        auto const rank = first + step;
+        if(!(step % seek_interval))
+            seeks.emplace_back(rank, offset);
+
+        auto const swap_indices = permute(permutation_counter);
+
+        // Swaps leaving even ranks are always (0, 1) and are not stored.
+        if(!(rank & 1))
+            continue;
+
+        std::uint64_t const i = std::get<0>(swap_indices),
+                            k = std::get<1>(swap_indices) - 1;
+
+        if(k < 16) {
+            out.put(char((i << 4) | k));
+            ++offset;
+        } else {
+            out.put(char(0));
+            ++offset;
+            put_varint(out, i, offset);
+            put_varint(out, k, offset);
+        }
+    }
+
+    if(seeks.empty())
+        seeks.emplace_back(first, 0);
+
+    h.seek_count  = seeks.size();
+    h.seek_offset = header_bytes + offset;
+
+    for(auto const& seek : seeks) {
+        put(out, seek.first, 8);
+        put(out, seek.second, 8);
+    }
+
+    out.seekp(0);
+    put_header(out, h);
+
+    return bool(out.flush());
+}
+
+// Map the file and validate its header and seek table.  The swaps are checked
+// as they are decoded.
+replayer::replayer(string const& path)
+: file_(path) {
+
+    if(file_.size() < header_bytes)
+        return;
+
+    header_ = get_header(file_.data());
+
+    bool const valid = header_.magic == magic
+                    && header_.version == version
+                    && header_.size >= 2
+                    && header_.first + header_.count >= header_.first
+                    && header_.seek_interval
+                    && header_.seek_count
+                    && header_.data_offset >= header_bytes
+                    && header_.data_offset <= header_.seek_offset
+                    && header_.seek_offset <= file_.size()
+                    && header_.seek_count
+                       <= (file_.size() - header_.seek_offset) / 16;
+
+    if(!valid)
+        return;
+
+    // Seek points must be in order, within the ranks and the swap data.
+    auto const data_bytes = header_.seek_offset - header_.data_offset;
+    std::uint64_t rank = header_.first, offset = 0;
+
+    for(std::uint64_t entry = 0; entry < header_.seek_count; ++entry) {
+
+        auto const seek        = file_.data() + header_.seek_offset + entry * 16;
+        auto const seek_rank   = get(seek, 8),
+                   seek_offset = get(seek + 8, 8);
+
+        if( seek_rank < rank || seek_rank - header_.first > header_.count
+         || seek_offset < offset || seek_offset > data_bytes)
+            return;
+
+        rank   = seek_rank;
+        offset = seek_offset;
+    }
+
+    data_       = file_.data() + header_.data_offset;
+    data_bytes_ = std::size_t(data_bytes);
+}
+
+// Find the nearest seek point at or before the rank and skip the stored swaps
+// between the two.
+bool replayer::locate(std::uint64_t rank, std::size_t& offset) const {
+
+    auto entry = (rank - header_.first) / header_.seek_interval;
+    if(entry >= header_.seek_count)
+        entry = header_.seek_count - 1;
+
+    auto const seek = file_.data() + header_.seek_offset + entry * 16;
+    auto       from = get(seek, 8);
+    offset          = std::size_t(get(seek + 8, 8));
+
+    for(std::size_t i, j; from < rank; ++from)
+        if(from & 1 && !decode(offset, i, j))
+            return false;
+
+    return true;
+}
+
+}
@@ -0,0 +1,178 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"../../Common_Include/mapped_file.h"
+#include<string>
+#include<cstddef>
+#include<cstdint>
+#include<cassert>
+#include<utility>
+
+// A compact file holding the swaps permute() produces for a range of ranks,
+// so one permutation schedule can be replayed by many consumers.
+//
+// The swap leaving an even rank always exchanges positions 0 and 1, so only
+// the swaps leaving odd ranks are stored, one byte each while the string has
+// at most 16 elements: the low nibble holds the prefix selector k (never 0
+// for these swaps) and the high nibble the first position i; the second
+// position is implied as k+1.  A low nibble of 0 escapes to two LEB128
+// values, i then k, for longer strings.  This averages half a byte per swap.
+//
+// Layout, all integers little endian:
+//  header      - see swap_stream::header below
+//  swap data   - the encoded swaps
+//  seek table  - (rank, data offset) pairs of 64-bit integers, one for every
+//                seek_interval ranks from the first
+namespace swap_stream {
+
+std::uint32_t const magic   = 0x53505753;   // "SWPS"
+std::uint16_t const version = 1;
+
+// The fixed size file header.
+struct header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t size;             // the string's length
+    std::uint64_t first;            // rank of the permutation replay starts at
+    std::uint64_t count;            // number of swaps in the stream
+    std::uint64_t seek_interval;    // ranks between seek points
+    std::uint64_t seek_count;       // entries in the seek table
+    std::uint64_t data_offset;      // file offset of the swap data
+    std::uint64_t seek_offset;      // file offset of the seek table
+};
+
+std::size_t const header_bytes = 56;
+
+// Write the count swaps leading away from the permutation of rank first of a
+// string of the given size.  Returns false on an I/O failure.
+bool write( std::string const& path
+          , std::size_t        size
+          , std::uint64_t      first
+          , std::uint64_t      count
+          , std::uint64_t      seek_interval = 1U << 16);
+
+// Memory maps a swap stream and replays its swaps.
+class replayer {
+public:
+    explicit replayer(std::string const& path);
+
+    // Disallow copy and move
+    replayer(replayer const&) = delete;
+    replayer(replayer&&) = delete;
+    replayer& operator=(replayer const&) = delete;
+    replayer& operator=(replayer&&) = delete;
+
+    // Test that the file was mapped and holds a valid header and seek table.
+    bool is_open() const { return data_ != nullptr; }
+
+    header const& info() const { return header_; }
+
+    // Invoke visit(i, j) for each swap leading from rank from to rank to,
+    // both within [first, first + count].  Returns false, having visited the
+    // swaps before it, at a stored swap that is truncated or names a position
+    // outside the string.
+    template<typename Visit_>
+    bool for_each(std::uint64_t from, std::uint64_t to, Visit_ visit) const;
+
+    // Apply the swaps leading from rank from to rank to to the buffer, which
+    // must hold the permutation of rank from (see swap_order::unrank()).
+    // Returns false as for_each() does.
+    template<typename T>
+    bool replay(T* buffer, std::uint64_t from, std::uint64_t to) const {
+        return for_each(from, to, [buffer](std::size_t i, std::size_t j) {
+                                      std::swap(buffer[i], buffer[j]);
+                                  });
+    }
+
+private:
+
+    // Find the data offset of the stored swap leaving the first odd rank at
+    // or after the rank provided.  Returns false on a corrupt swap.
+    bool locate(std::uint64_t rank, std::size_t& offset) const;
+
+    // Decode one stored swap at offset, advancing offset past it.  Returns
+    // false when it runs past the swap data or outside the string.
+    bool decode(std::size_t& offset, std::size_t& i, std::size_t& j) const {
+
+        if(offset >= data_bytes_)
+            return false;
+
+        std::uint8_t const byte = data_[offset++];
+        if(byte & 0x0F) {
+            i = byte >> 4;
+            j = (byte & 0x0F) + 1U;
+        } else {
+            if(!decode_varint(offset, i) || !decode_varint(offset, j))
+                return false;
+            ++j;
+        }
+
+        return i < j && j < header_.size;
+    }
+
+    bool decode_varint(std::size_t& offset, std::size_t& value) const {
+        value = 0;
+        for( unsigned shift = 0
+           ; offset < data_bytes_ && shift < 8 * sizeof(std::size_t)
+           ; shift += 7) {
+            std::uint8_t const byte = data_[offset++];
+            value |= std::size_t(byte & 0x7F) << shift;
+            if(!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    header               header_;
+    mapped_file          file_;                 // the whole mapped file
+    std::uint8_t const*  data_  { nullptr };    // the swap data
+    std::size_t          data_bytes_ { 0 };     // up to the seek table
+};
+
+// Invoke visit(i, j) for each swap leading from rank from to rank to.
+template<typename Visit_>
+bool replayer::for_each(std::uint64_t from, std::uint64_t to, Visit_ visit) const {
+
+    assert(is_open());
+    assert(header_.first <= from && from <= to
+           && to <= header_.first + header_.count);
+
+    std::size_t offset;
+    if(!locate(from, offset))
+        return false;
+
+    for(auto rank = from; rank < to; ++rank) {
+
+        // Swaps leaving even ranks are implied.
+        if(!(rank & 1)) {
+            visit(std::size_t(0), std::size_t(1));
+            continue;
+        }
+
+        std::size_t i, j;
+        if(!decode(offset, i, j))
+            return false;
+        visit(i, j);
+    }
+
+    return true;
+}
+
+}
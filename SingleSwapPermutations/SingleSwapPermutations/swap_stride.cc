@@ -0,0 +1,177 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#include"swap_stride.h"
+#include"swap_rank.h"
+#include"../../Common_Include/factorial_base_manipulation.h"
+#include"../../Common_Include/instrumentation.h"
+using factorial_base::Number;
+using frame_arena::generator;
+using std::string;
+#include<cassert>
+#include<memory>
+#include<utility>
+#include<vector>
+
+namespace {
+
+// The index list of a permutation state, unranked from its most significant
+// digit down.  Each prefix length keeps the composition of the blocks of the
+// digits above it, so when only the digits below some prefix length change,
+// only the positions below it are unranked again.
+class swap_cursor {
+public:
+
+    explicit swap_cursor(swap_order const& order)
+    : order_(order)
+    , maps_(order.size() * (order.size() + 1) / 2)
+    , indices_(order.size()) {
+
+        // Above the most significant digit nothing is composed.
+        auto const top = map(order.size());
+        for(std::size_t i = 0; i < order.size(); ++i)
+            top[i] = unsigned(i);
+    }
+
+    // Unrank the positions below prefix length m from the state provided,
+    // whose digits from m-1 up are those last unranked.
+    void unrank(Number const& state, std::size_t m) {
+
+        for(; m >= 2; --m) {
+            auto const arrangement = order_.block(m, state[m - 2]);
+            auto const above = map(m),
+                       below = map(m - 1);
+            for(std::size_t i = 0; i + 1 < m; ++i)
+                below[i] = above[arrangement[i]];
+            indices_[m - 1] = above[arrangement[m - 1]];
+        }
+
+        indices_[0] = map(1)[0];
+    }
+
+    unsigned operator[](std::size_t i) const { return indices_[i]; }
+
+private:
+
+    // The composition of the blocks above prefix length m, m elements.
+    unsigned* map(std::size_t m) { return &maps_[m * (m - 1) / 2]; }
+
+    swap_order const&      order_;
+    std::vector<unsigned>  maps_,
+                           indices_;
+};
+
+// Enumerate every stride-th permutation with the order provided or, if
+// none, one built for the string.
+generator<string> stride_through( swap_order const*  shared
+                                , string const&      in
+                                , Number             first
+                                , Number             stride
+                                , std::uint64_t      count) {
+
+    assert(factorial_base::compare(stride, Number{}) > 0);
+
+    if(in.empty())
+        co_return;
+
+    std::unique_ptr<swap_order> built;
+    if(!shared)
+        built.reset(new swap_order(in.size()));
+    auto const& order = shared ? *shared : *built;
+
+    assert(order.size() == in.size());
+
+    // As for permute(), a state grown to the string's size is beyond the
+    // final permutation.
+    auto const digits = in.size() - 1;
+
+    while(first.size() > digits && !first.back())
+        first.pop_back();
+    if(first.size() < digits)
+        first.resize(digits, 0U);
+
+    swap_cursor cursor(order);
+    Number previous;
+    string result(in.size(), '\0');
+
+    // The positions unranked again, all of them at first.
+    auto changed = in.size();
+
+    for(; count && first.size() <= digits; --count) {
+
+        cursor.unrank(first, changed);
+        for(std::size_t i = 0; i < changed; ++i)
+            result[i] = in[cursor[i]];
+
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield result;
+        INSTRUMENT_COUNT(resumes, 1);
+
+        previous = first;
+        factorial_base::add(first, stride);
+
+        if(first.size() > digits)
+            break;
+
+        // Positions up to and including the highest digit changed's index
+        // plus one are affected.
+        changed = digits;
+        while(changed && first[changed - 1] == previous[changed - 1])
+            --changed;
+        ++changed;
+    }
+}
+
+}
+
+// Return a yield generator enumerating every stride-th permutation of the
+// string provided.
+generator<string> swap_stride( swap_order const&  order
+                             , string const&      in
+                             , Number             first
+                             , Number             stride
+                             , std::uint64_t      count) {
+    return stride_through(&order, in, std::move(first), std::move(stride), count);
+}
+
+generator<string> swap_stride( string const&  in
+                             , Number         first
+                             , Number         stride
+                             , std::uint64_t  count) {
+    return stride_through(nullptr, in, std::move(first), std::move(stride), count);
+}
+
+// Return a yield generator enumerating count evenly spread permutations of
+// the string provided.
+generator<string> swap_sample( swap_order const&  order
+                             , string const&      in
+                             , unsigned           count) {
+
+    Number stride;
+    factorial_base::spread(stride, in.size(), count);
+
+    return swap_stride(order, in, Number{}, stride, count);
+}
+
+generator<string> swap_sample(string const& in, unsigned count) {
+
+    Number stride;
+    factorial_base::spread(stride, in.size(), count);
+
+    return swap_stride(in, Number{}, stride, count);
+}
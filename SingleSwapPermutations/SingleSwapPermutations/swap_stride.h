@@ -0,0 +1,59 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"../../Common_Include/factorial_base_common.h"
+#include"../../Common_Include/frame_arena.h"
+#include<string>
+#include<cstdint>
+#include<limits>
+
+class swap_order;
+
+// Return a yield generator enumerating every stride-th permutation of the
+// string provided in the order permute() visits them, starting from the one
+// reached after first swaps (the string itself is first 0), up to count of
+// them.  Rather than applying the swaps between, each step adds the stride
+// to the permutation state and unranks again only the positions below its
+// highest digit changed, O(n) for a stride of a few low digits.  The order
+// given, of the string's size, must outlive the generator.
+frame_arena::generator<std::string>
+swap_stride( swap_order const&             order
+           , std::string const&            in
+           , factorial_base::Number        first
+           , factorial_base::Number        stride
+           , std::uint64_t                 count
+                 = std::numeric_limits<std::uint64_t>::max());
+
+// As above, building a swap_order for the string, in O(n^3).
+frame_arena::generator<std::string>
+swap_stride( std::string const&            in
+           , factorial_base::Number        first
+           , factorial_base::Number        stride
+           , std::uint64_t                 count
+                 = std::numeric_limits<std::uint64_t>::max());
+
+// Return a yield generator enumerating count permutations of the string
+// provided spread evenly over the order permute() visits them, starting from
+// the string itself.
+frame_arena::generator<std::string>
+swap_sample(swap_order const& order, std::string const& in, unsigned count);
+
+frame_arena::generator<std::string>
+swap_sample(std::string const& in, unsigned count);
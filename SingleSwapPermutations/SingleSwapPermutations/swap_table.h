@@ -0,0 +1,144 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of SingleSwapPermutations.
+//
+// SingleSwapPermutations is free software: you can redistribute it
+// and/or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// SingleSwapPermutations is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SingleSwapPermutations.  If not,
+// see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include"permutation_from_swap.h"
+#include"../../Common_Include/instrumentation.h"
+#include"../../Common_Include/frame_arena.h"
+#include<string>
+#include<cstddef>
+#include<cassert>
+#include<utility>
+
+// The string positions exchanged by one permutation step.
+struct swap_pair {
+    unsigned char first,
+                  second;
+};
+
+// The complete sequence of swaps, as returned by permute(), enumerating the
+// permutations of an N element string.  The sequence for a shorter string is
+// a prefix of this one.
+template<std::size_t N>
+struct swap_table {
+    static_assert(N >= 2, "a swap table requires at least two elements");
+    static constexpr std::size_t size = factorial_base::factorial(N) - 1;
+
+    swap_pair swaps[size];
+};
+
+// Build the swap table for an N element string at compile time.
+template<std::size_t N>
+constexpr swap_table<N> make_swap_table() {
+
+    swap_table<N> table{};
+
+    // The permutation state; only the first N-1 digits are ever reached.
+    unsigned digits[N] = {};
+
+    for(std::size_t step = 0; step < table.size; ++step) {
+
+        // Increment the permutation state as factorial_base::increment() does.
+        unsigned i = 0;
+        while(++digits[i] > i + 1)
+            digits[i++] = 0;
+
+        auto const indices = digit_to_swap_indices(i, digits[i]);
+        table.swaps[step] = swap_pair{ (unsigned char)std::get<0>(indices)
+                                     , (unsigned char)std::get<1>(indices) };
+    }
+
+    return table;
+}
+
+// Yields the permutations of an N element string by walking its compile time
+// swap table.
+template<std::size_t N>
+frame_arena::generator<std::string> iterate_fixed(std::string const& in) {
+
+    static constexpr swap_table<N> table = make_swap_table<N>();
+
+    assert(in.size() == N);
+    std::string result{in};
+
+    for(auto const& swap : table.swaps) {
+        std::swap(result[swap.first], result[swap.second]);
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield result;
+        INSTRUMENT_COUNT(resumes, 1);
+    }
+}
+
+// Yields the permutations of a string of any length.  The swaps among the
+// first M positions repeat identically between every carry into the higher
+// digits, so they are walked from the size M table as an unrolled inner block
+// and the runtime counter is only incremented once per M! permutations.
+template<std::size_t M>
+frame_arena::generator<std::string> iterate_blocked(std::string const& in) {
+
+    static constexpr swap_table<M> table = make_swap_table<M>();
+
+    std::string result{in};
+    auto const string_size = in.size();
+
+    // Strings no longer than the block are enumerated by a table prefix.
+    if(string_size <= M) {
+        auto const steps = factorial_base::factorial(string_size) - 1;
+        for(std::size_t step = 0; step < steps; ++step) {
+            std::swap( result[table.swaps[step].first]
+                     , result[table.swaps[step].second]);
+            INSTRUMENT_COUNT(permutations, 1);
+            co_yield result;
+            INSTRUMENT_COUNT(resumes, 1);
+        }
+        co_return;
+    }
+
+    // The permutation state.  Digits below M-1 are only brought up to date at
+    // the end of each block, where the table walk has left them at their
+    // maximum.
+    factorial_base::Number permutation_counter(M - 1, 0);
+
+    for(;;) {
+
+        for(auto const& swap : table.swaps) {
+            std::swap(result[swap.first], result[swap.second]);
+            INSTRUMENT_COUNT(permutations, 1);
+            co_yield result;
+            INSTRUMENT_COUNT(resumes, 1);
+        }
+
+        for(unsigned i = 0; i + 1 < M; ++i)
+            permutation_counter[i] = i + 1;
+
+        // Get the string positions to swap, carrying into the higher digits.
+        auto swap_indices = permute(permutation_counter);
+
+        // Test loop end condition.
+        if(permutation_counter.size() >= string_size)
+            break;
+
+        std::swap( result[std::get<0>(swap_indices)]
+                 , result[std::get<1>(swap_indices)]);
+
+        INSTRUMENT_COUNT(permutations, 1);
+        co_yield result;
+        INSTRUMENT_COUNT(resumes, 1);
+    }
+}
@@ -0,0 +1,190 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#include"GroupSpeller.h"
+#include"Keypad.h"
+#include"../../Common_Include/instrumentation.h"
+using std::string;
+#include<algorithm>
+#include<cstring>
+#include<cctype>
+#include<cassert>
+
+namespace Spellephone {
+
+// Build the tables for all groups of 1 thru groupSize digits.
+SpellingTables::SpellingTables(std::size_t groupSize)
+: group_size_(groupSize)
+, entries_(groupSize + 1) {
+
+    assert(groupSize > 0 && groupSize <= 6);
+
+    std::size_t groups = 1;
+
+    for(std::size_t length = 1; length <= groupSize; ++length) {
+
+        groups *= 10;
+        entries_[length].resize(groups);
+
+        string digits(length, '0');
+
+        for(std::size_t value = 0; value < groups; ++value) {
+
+            // The group's digits, most significant first.
+            for(std::size_t i = length, rest = value; i--; rest /= 10)
+                digits[i] = char('0' + rest % 10);
+
+            Entry& entry = entries_[length][value];
+            entry.first = std::uint32_t(letters_.size());
+            entry.count = 1;
+
+            for(auto digit : digits)
+                entry.count *= std::uint32_t(button_letters[t2index(digit)].size());
+
+            // Count through the group's spellings, the last digit fastest.
+            std::vector<std::size_t> letter(length, 0);
+
+            for(std::uint32_t spelling = 0; spelling < entry.count; ++spelling) {
+
+                for(std::size_t i = 0; i < length; ++i)
+                    letters_.push_back(button_letters[t2index(digits[i])][letter[i]]);
+
+                for(std::size_t i = length; i--; ) {
+                    if(++letter[i] < button_letters[t2index(digits[i])].size())
+                        break;
+                    letter[i] = 0;
+                }
+            }
+        }
+    }
+}
+
+// Return the table of the length digits provided.
+SpellingTables::Table SpellingTables::lookup( char const* digits
+                                            , std::size_t length) const {
+
+    assert(length > 0 && length <= group_size_);
+
+    std::size_t value = 0;
+    for(std::size_t i = 0; i < length; ++i)
+        value = value * 10 + t2index(digits[i]);
+
+    auto const& entry = entries_[length][value];
+
+    return Table{ letters_.data() + entry.first
+                , entry.count
+                , length };
+}
+
+GroupSpeller::GroupSpeller( SpellingTables const& tables
+                          , string const&         phoneNumber)
+: current_(phoneNumber) {
+
+    string digits;
+    stripNondigits(digits, phoneNumber);
+
+    // Positions of the digits within the phone number.
+    std::vector<std::size_t> positions;
+    for(std::size_t i = 0; i < phoneNumber.size(); ++i)
+        if(std::isdigit((unsigned char)phoneNumber[i]))
+            positions.push_back(i);
+
+    auto const size = tables.groupSize();
+
+    for(std::size_t first = 0; first < digits.size(); first += size) {
+
+        auto const length = std::min(size, digits.size() - first);
+
+        Group group;
+        group.table = tables.lookup(digits.data() + first, length);
+        group.positions.assign( positions.begin() + first
+                              , positions.begin() + first + length);
+        group.contiguous = group.positions.back() - group.positions.front()
+                           == length - 1;
+
+        place(group);
+        groups_.push_back(std::move(group));
+    }
+}
+
+// Copy the group's current spelling into current_.
+void GroupSpeller::place(Group const& group) {
+
+    auto const spelling = group.table.spellings
+                        + group.index * group.table.width;
+
+    if(group.contiguous)
+        std::memcpy(&current_[group.positions.front()], spelling, group.table.width);
+    else
+        for(std::size_t i = 0; i < group.table.width; ++i)
+            current_[group.positions[i]] = spelling[i];
+}
+
+// Advance the groups as an odometer, the last group fastest.
+bool GroupSpeller::advance() {
+
+    for(auto group = groups_.rbegin(); group != groups_.rend(); ++group) {
+
+        if(++group->index < group->table.count) {
+            place(*group);
+            return true;
+        }
+
+        group->index = 0;
+        place(*group);
+    }
+
+    return false;
+}
+
+// Write up to count further spellings consecutively into out.
+std::size_t GroupSpeller::next(char* out, std::size_t count) {
+
+    auto const width = current_.size();
+    std::size_t written = 0;
+
+    for(; written < count && !done_; ++written, out += width) {
+        std::memcpy(out, current_.data(), width);
+        done_ = !advance();
+    }
+
+    INSTRUMENT_COUNT(permutations, written);
+    return written;
+}
+
+// Return the next spelling, or an empty string at the end.
+string GroupSpeller::next() {
+
+    if(done_)
+        return string();
+
+    string result(current_);
+    done_ = !advance();
+
+    INSTRUMENT_COUNT(permutations, 1);
+    return result;
+}
+
+// The number of spellings in all.
+std::uint64_t GroupSpeller::size() const {
+    std::uint64_t total = 1;
+    for(auto const& group : groups_)
+        total *= group.table.count;
+    return total;
+}
+
+}
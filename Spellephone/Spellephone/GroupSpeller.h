@@ -0,0 +1,104 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+namespace Spellephone {
+
+// The spellings of every digit group of up to a given length, built once.
+// A group of three digits has at most 4^3 = 64 spellings of 3 letters.
+// Nothing is modified after construction, so one instance may be shared by
+// any number of threads spelling different numbers.
+class SpellingTables {
+public:
+
+    // The spellings of one digit group, each width letters long, stored
+    // consecutively in the order PhoneNumberEnumerator produces them.
+    struct Table {
+        char const*  spellings;
+        std::size_t  count,
+                     width;
+    };
+
+    // Build the tables for all groups of 1 thru groupSize digits.  A group
+    // size of 4 takes about 2.5 MB.
+    explicit SpellingTables(std::size_t groupSize = 3);
+
+    std::size_t groupSize() const { return group_size_; }
+
+    // Return the table of the length digits provided, at most groupSize().
+    Table lookup(char const* digits, std::size_t length) const;
+
+private:
+
+    // First spelling and count of each group, indexed by length and then by
+    // the group's digits read as a decimal number.
+    struct Entry {
+        std::uint32_t first,
+                      count;
+    };
+
+    std::size_t                     group_size_;
+    std::vector<char>               letters_;
+    std::vector<std::vector<Entry>> entries_;
+};
+
+// Enumerates the spellings of a phone number in the order
+// PhoneNumberEnumerator does, a group of digits at a time.  The number's
+// digits are split into groups of the tables' group size, and each spelling
+// differs from the one before only in the groups that advanced, which are
+// copied from their tables.  Most spellings cost one group copy and one copy
+// of the whole number.
+class GroupSpeller {
+public:
+    GroupSpeller(SpellingTables const& tables, std::string const& phoneNumber);
+
+    // Write up to count further spellings consecutively into out, each as
+    // long as the phone number.  Returns the number written, 0 at the end.
+    std::size_t next(char* out, std::size_t count);
+
+    // Return the next spelling, or an empty string at the end.
+    std::string next();
+
+    // The number of spellings in all.
+    std::uint64_t size() const;
+
+private:
+
+    struct Group {
+        SpellingTables::Table    table;
+        std::size_t              index { 0 };
+        std::vector<std::size_t> positions;     // within the phone number
+        bool                     contiguous;
+    };
+
+    // Copy the group's current spelling into current_.
+    void place(Group const& group);
+
+    // Advance to the next spelling, returning false after the last.
+    bool advance();
+
+    std::vector<Group> groups_;
+    std::string        current_;                // the spelling to emit
+    bool               done_ { false };
+};
+
+}
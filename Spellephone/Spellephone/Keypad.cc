@@ -0,0 +1,66 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#include"Keypad.h"
+#include<limits>
+#include<cassert>
+
+namespace Spellephone {
+
+std::string const button_letters[10] =
+{          "0"
+,  "1",   "abc", "def"
+,  "ghi", "jkl", "mno"
+, "pqrs", "tuv", "wxyz" };
+
+std::uint64_t spellingCount(std::string const& phoneNumber) {
+
+    std::uint64_t count = 1;
+
+    for(auto ch : phoneNumber) {
+
+        if(!std::isdigit((unsigned char)ch))
+            continue;
+
+        auto const letters = button_letters[t2index(ch)].size();
+        if(count > std::numeric_limits<std::uint64_t>::max() / letters)
+            return std::numeric_limits<std::uint64_t>::max();
+        count *= letters;
+    }
+
+    return count;
+}
+
+// Take each digit's letter from the index, last digit first.
+void spell(std::string& out, std::string const& phoneNumber, std::uint64_t index) {
+
+    out = phoneNumber;
+
+    for(auto ch = out.rbegin(); ch != out.rend(); ++ch) {
+
+        if(!std::isdigit((unsigned char)*ch))
+            continue;
+
+        auto const& letters = button_letters[t2index(*ch)];
+        *ch = letters[std::size_t(index % letters.size())];
+        index /= letters.size();
+    }
+
+    assert(!index);
+}
+
+}
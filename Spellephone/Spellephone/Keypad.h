@@ -0,0 +1,56 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<algorithm>
+#include<iterator>
+#include<cctype>
+#include<cstdint>
+
+namespace Spellephone {
+
+// Each string indexed by i (0 <= i <= 9) holds the letters found on a phone
+// button numbered i.  Buttons with no letters use their digit as their only
+// letter.
+extern std::string const button_letters[10];
+
+// Copy the digits from argument in to argument out.  Non-digit characters in
+// argument in are ignored
+inline void stripNondigits(std::string& out, std::string const& in) {
+    std::copy_if(in.begin(), in.end(), std::back_inserter(out),
+                 [](std::string::value_type ch) {
+                     return std::isdigit((unsigned char)ch);
+                 });
+}
+
+// Convert a character digit to binary
+template<typename T>
+inline int t2index(T ch) {
+    return int(ch - T('0'));
+}
+
+// Return the number of spellings of the phone number, or the largest 64-bit
+// value when there are more.
+std::uint64_t spellingCount(std::string const& phoneNumber);
+
+// Write the spelling of the given index, less than spellingCount(), in the
+// order PhoneNumberEnumerator produces them: an odometer whose last digit's
+// letter turns fastest.
+void spell(std::string& out, std::string const& phoneNumber, std::uint64_t index);
+
+}
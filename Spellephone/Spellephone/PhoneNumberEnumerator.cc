@@ -24,25 +24,17 @@ using std::unique_ptr;
 using std::isdigit;
 #include<iterator>
 #include<type_traits>
-
-// Copy the digits from argument in to argument out.  Non-digit characters in
-// argument in are ignored
-inline void stripNondigits(string& out, string const& in) {
-    std::copy_if(in.begin(), in.end(), std::back_inserter(out),
-                 [](string::value_type ch) {
-                     return isdigit(ch);
-                 });
-}
+#include"Keypad.h"
+#include"SpellingCache.h"
+using Spellephone::button_letters;
+using Spellephone::stripNondigits;
+using Spellephone::t2index;
 
 // Implementation of the phone number enumerator.  A separate implementation
 // relieves the consumer of having to carry along the baggage in Spellephone.h
 // and of even knowing about the coroutines being used.
 struct PhoneNumberEnumerator::Impl {
 
-    // Each string indexed by i (0 <= i <= 9) holds the letters found on a phone
-    // button numbered i.
-    static string const button_letters[];
-
     // Type name helpers
     using Counters_type = Spellephone::Counters<int>;
     using Counters_ptr = unique_ptr<Counters_type>;
@@ -54,6 +46,11 @@ struct PhoneNumberEnumerator::Impl {
     using permutation_generator = decltype(decltype_hack->next_permutation());
 #   undef decltype_hack
 
+    // The arena holding the coroutine frames of counters_ and generator_,
+    // one per digit plus one, released together with this object.  It is
+    // declared first so it is destroyed last.
+    frame_arena::arena arena_;
+
     // The permuter of indices (into button_letters)
     Counters_ptr counters_{nullptr};
 
@@ -65,25 +62,25 @@ struct PhoneNumberEnumerator::Impl {
 
     string const& phone_number_;        // the incoming phone number
 
+    // The cached spellings, in place of the above, and the next to return.
+    unique_ptr<Spellephone::SpellingCache::Spellings> cached_;
+    std::uint64_t                                      cached_next_ { 0 };
+
     Impl(string const& phoneNumber);    // the constructor
+    Impl( string const& phoneNumber
+        , Spellephone::SpellingCache& cache);
+    void start();                       // begin enumerating uncached
     string next();                      // the enumerating method
 };
 
-string const PhoneNumberEnumerator::Impl::button_letters[] =
-{          "0"
-,  "1",   "abc", "def"
-,  "ghi", "jkl", "mno"
-, "pqrs", "tuv", "wxyz" };
-
-// Convert a character digit to binary
-template<typename T>
-inline int t2index(T ch) {
-    return int(ch - T('0'));
-}
-
 // Construct the implementation
 PhoneNumberEnumerator::Impl::Impl(string const& phoneNumber)
 : phone_number_(phoneNumber) {
+    start();
+}
+
+// Set up the counters enumerating the spellings as they are asked for.
+void PhoneNumberEnumerator::Impl::start() {
 
     // Strip the non-digits from the phone number.
     string all_digits;
@@ -102,14 +99,30 @@ PhoneNumberEnumerator::Impl::Impl(string const& phoneNumber)
 
     // Create the counters from the sizes for each digit.
     // Get the coroutine generator and it's associated iterator.
+    // Their coroutine frames all come from this enumerator's arena.
+    frame_arena::scope frames(arena_);
     counters_ = Counters_ptr(new Counters_type(sizes.begin(), sizes.end()));
     generator_ = std::move(counters_->next_permutation());
     iterator_ = generator_.begin();
 }
 
+// Construct the implementation over cached spellings, or enumerate them as
+// they are asked for when there are too many to cache.
+PhoneNumberEnumerator::Impl::Impl( string const& phoneNumber
+                                 , Spellephone::SpellingCache& cache)
+: phone_number_(phoneNumber)
+, cached_(cache.lookup(phoneNumber)) {
+    if(!cached_)
+        start();
+}
+
 // Genereate the next permutation.
 string PhoneNumberEnumerator::Impl::next() {
 
+    if(cached_)
+        return cached_next_ < cached_->size() ? (*cached_)[cached_next_++]
+                                              : string();
+
     // Return an empty string once enumeration is completed.
     if(iterator_ == generator_.end())
         return string();
@@ -162,6 +175,11 @@ PhoneNumberEnumerator::PhoneNumberEnumerator(string const& phoneNumber):
 impl_{Impl_ptr{new Impl(phoneNumber)}}
 { }
 
+PhoneNumberEnumerator::PhoneNumberEnumerator( string const& phoneNumber
+                                            , Spellephone::SpellingCache& cache):
+impl_{Impl_ptr{new Impl(phoneNumber, cache)}}
+{ }
+
 PhoneNumberEnumerator::~PhoneNumberEnumerator() { }
 
 string PhoneNumberEnumerator::next() {
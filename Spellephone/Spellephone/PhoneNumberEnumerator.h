@@ -19,10 +19,18 @@
 #include<memory>
 #include<string>
 
+namespace Spellephone { class SpellingCache; }
+
 // Enumerates the spellings of the phone number supplied.
 class PhoneNumberEnumerator {
 public:
     PhoneNumberEnumerator(std::string const& phoneNumber);
+
+    // Enumerate the spellings held by the cache for the phone number's
+    // digits, adding them on a miss.
+    PhoneNumberEnumerator( std::string const&        phoneNumber
+                         , Spellephone::SpellingCache& cache);
+
     ~PhoneNumberEnumerator();
 
     // Disallow copy and move
@@ -16,12 +16,13 @@
 // along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
-#include<experimental/generator>
+#include"../../Common_Include/frame_arena.h"
 #include<initializer_list>
 #include<vector>
 #include<cassert>
 #include<algorithm>
 #include<memory>
+#include"../../Common_Include/instrumentation.h"
 
 namespace Spellephone {
 
@@ -29,7 +30,7 @@ namespace Spellephone {
 template<typename Base_>
 struct Counter {
     using value_type = Base_;
-    using generator_type = std::experimental::generator<int>;
+    using generator_type = frame_arena::generator<int>;
 
     Base_ maximum_;             // The sequence modulus
     bool  wrapped_ { false };   // Indicator that the sequence has wrapped to 0
@@ -43,7 +44,8 @@ struct Counter {
     Counter& operator=(Counter&&) = delete;
 
     // Uses Microsoft Visual Studio 2015 "resumable" function, co_yield to
-    // enumerate this counter's values.
+    // enumerate this counter's values.  The frame comes from the calling
+    // thread's frame_arena, if one is bound.
     generator_type get_generator() {
 
         // This counter's current value
@@ -53,6 +55,7 @@ struct Counter {
 
             // Yield the current value and wait to resume
             co_yield i;
+            INSTRUMENT_COUNT(resumes, 1);
 
             // On resume, increment current value (mod maximum_) and
             // set flag to true if wrapped to 0, else false.
@@ -75,6 +78,7 @@ struct Counters {
     using generator_type     = typename counter_type::generator_type;
     using generator_iterator = typename generator_type::iterator;
     using index_coll_type    = std::vector<Base_>;
+    using index_generator    = frame_arena::generator<index_coll_type>;
     using initializer_list   = std::initializer_list<size_t>;
 
     // Instantiation particular traits.
@@ -143,7 +147,7 @@ struct Counters {
     Counters& operator=(Counters&&) = delete;
 
     // Returns a generator of index_coll_type whose iterator yields permutations
-    auto next_permutation();
+    index_generator next_permutation();
 };
 
 // Initialize the counters and first permutation.
@@ -179,12 +183,15 @@ Counters<Base_>::Counters(Iter_ first, Iter_ last) {
 
 // Returns a generator of index_coll_type whose iterator yields permutations
 template<typename Base_>
-auto Counters<Base_>::next_permutation() {
+typename Counters<Base_>::index_generator
+Counters<Base_>::next_permutation() {
 
     do {
 
         // return the first permutation already initialized in the constructor.
+        INSTRUMENT_COUNT(permutations, 1);
         co_yield permutation_;
+        INSTRUMENT_COUNT(resumes, 1);
 
         auto end = counters_.rend();
         auto digit = permutation_.rbegin();
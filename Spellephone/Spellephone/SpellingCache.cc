@@ -0,0 +1,165 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#include"SpellingCache.h"
+#include"Spellephone.h"
+#include"Keypad.h"
+using std::string;
+#include<cctype>
+#include<limits>
+
+namespace Spellephone {
+
+// Write spelling i, putting each letter where its digit was.
+void SpellingCache::Spellings::spell(string& out, std::uint64_t i) const {
+
+    out.resize(phone_number_.size());
+
+    std::size_t k = 0;
+
+    for(std::size_t p = 0; p < phone_number_.size(); ++p) {
+        auto const ch = phone_number_[p];
+        out[p] = std::isdigit((unsigned char)ch)
+               ? button_letters[t2index(ch)][entry_->letter(i, k++)]
+               : ch;
+    }
+}
+
+SpellingCache::SpellingCache(std::size_t capacityBytes)
+: capacity_(capacityBytes) {
+}
+
+std::size_t SpellingCache::entry_bytes(string const& digits) {
+
+    auto const count = spellingCount(digits),
+               most  = std::uint64_t(std::numeric_limits<std::size_t>::max());
+
+    // Two bits per digit per spelling, with room for the rounding.
+    if(!digits.empty() && count > (most - 7) / (digits.size() * 2))
+        return std::numeric_limits<std::size_t>::max();
+
+    auto const letters = (count * digits.size() * 2 + 7) / 8;
+    if(letters > most - sizeof(Entry) - digits.size())
+        return std::numeric_limits<std::size_t>::max();
+
+    return std::size_t(sizeof(Entry) + digits.size() + letters);
+}
+
+// Enumerate the spellings with the same counters PhoneNumberEnumerator uses.
+// The digits' entry_bytes() must be within the capacity.
+std::shared_ptr<SpellingCache::Entry const>
+SpellingCache::enumerate(string const& digits) {
+
+    auto entry = std::make_shared<Entry>();
+    entry->digits = digits;
+    entry->count  = spellingCount(digits);
+
+    std::vector<std::size_t> sizes;
+    for(auto digit : digits)
+        sizes.push_back(button_letters[t2index(digit)].size());
+
+    entry->letters.assign((entry->count * digits.size() * 2 + 7) / 8, 0);
+
+    if(digits.empty())
+        return entry;
+
+    frame_arena::arena frames_arena;
+    frame_arena::scope frames(frames_arena);
+
+    Counters<int> counters(sizes.begin(), sizes.end());
+
+    std::uint64_t bit = 0;
+
+    for(auto const& permutation : counters.next_permutation())
+        for(auto letter : permutation) {
+            entry->letters[bit / 8] |= std::uint8_t(letter << (bit % 8));
+            bit += 2;
+        }
+
+    return entry;
+}
+
+// Return the spellings of the phone number.
+std::unique_ptr<SpellingCache::Spellings>
+SpellingCache::lookup(string const& phoneNumber) {
+
+    string digits;
+    stripNondigits(digits, phoneNumber);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const found = slots_.find(digits);
+        if(found != slots_.end()) {
+            recency_.splice(recency_.begin(), recency_, found->second.recency);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return std::unique_ptr<Spellings>(
+                       new Spellings(found->second.entry, phoneNumber));
+        }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
+    // Spellings that could never be kept are left to the caller to stream.
+    if(entry_bytes(digits) > capacity_)
+        return nullptr;
+
+    // Enumerate without holding the lock.
+    auto entry = enumerate(digits);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another thread may have added the same digits meanwhile.
+    auto const found = slots_.find(digits);
+    if(found != slots_.end())
+        return std::unique_ptr<Spellings>(
+                   new Spellings(found->second.entry, phoneNumber));
+
+    // Make room, least recently used first.
+    while(bytes_ + entry->bytes() > capacity_) {
+        auto const victim = slots_.find(recency_.back());
+        bytes_ -= victim->second.entry->bytes();
+        slots_.erase(victim);
+        recency_.pop_back();
+    }
+
+    recency_.push_front(digits);
+    slots_.emplace(digits, Slot{ entry, recency_.begin() });
+    bytes_ += entry->bytes();
+
+    return std::unique_ptr<Spellings>(
+               new Spellings(std::move(entry), phoneNumber));
+}
+
+std::size_t SpellingCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+std::size_t SpellingCache::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+}
+
+void SpellingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    recency_.clear();
+    bytes_ = 0;
+}
+
+}
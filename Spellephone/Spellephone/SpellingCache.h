@@ -0,0 +1,127 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include<string>
+#include<vector>
+#include<list>
+#include<unordered_map>
+#include<memory>
+#include<mutex>
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+
+namespace Spellephone {
+
+// A bounded, thread safe, least recently used cache of the spellings of phone
+// numbers, keyed by their digits alone, so numbers differing only in
+// punctuation share an entry.  An entry holds, for each spelling, the index
+// of each digit's letter on its button, two bits apiece.  Each caller's
+// punctuation is put back as its spellings are read.
+class SpellingCache {
+public:
+
+    // The spellings of one number's digits, shared by every number having
+    // them.
+    struct Entry {
+        std::string               digits;
+        std::uint64_t             count;    // number of spellings
+        std::vector<std::uint8_t> letters;  // 2-bit letter indices
+
+        // The letter index of digit k of spelling i.
+        unsigned letter(std::uint64_t i, std::size_t k) const {
+            auto const bit = (i * digits.size() + k) * 2;
+            return (letters[bit / 8] >> (bit % 8)) & 3;
+        }
+
+        std::size_t bytes() const {
+            return sizeof(Entry) + digits.size() + letters.size();
+        }
+    };
+
+    // A phone number's spellings: its punctuation over a shared entry.
+    class Spellings {
+    public:
+        Spellings(std::shared_ptr<Entry const> entry, std::string phoneNumber)
+        : entry_(std::move(entry)), phone_number_(std::move(phoneNumber)) { }
+
+        std::uint64_t size() const { return entry_->count; }
+
+        // Write spelling i, as PhoneNumberEnumerator would produce it.
+        void spell(std::string& out, std::uint64_t i) const;
+
+        std::string operator[](std::uint64_t i) const {
+            std::string out;
+            spell(out, i);
+            return out;
+        }
+
+    private:
+        std::shared_ptr<Entry const> entry_;
+        std::string                  phone_number_;
+    };
+
+    // Hold entries of up to the given number of bytes in all.
+    explicit SpellingCache(std::size_t capacityBytes = std::size_t(64) << 20);
+
+    // Disallow copy and move
+    SpellingCache(SpellingCache const&) = delete;
+    SpellingCache(SpellingCache&&) = delete;
+    SpellingCache& operator=(SpellingCache const&) = delete;
+    SpellingCache& operator=(SpellingCache&&) = delete;
+
+    // Return the spellings of the phone number, enumerating and caching them
+    // on a miss.  Returns null, enumerating nothing, when they would take more
+    // than the whole capacity; the caller enumerates those as it goes.
+    std::unique_ptr<Spellings> lookup(std::string const& phoneNumber);
+
+    // Tuning statistics.
+    std::uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    std::uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+    std::size_t   bytes() const;
+    std::size_t   entries() const;
+    std::size_t   capacity() const { return capacity_; }
+
+    void clear();
+
+private:
+
+    // The bytes an entry for the digits would take, or the largest value
+    // when that does not fit a size_t.
+    static std::size_t entry_bytes(std::string const& digits);
+
+    // Enumerate the spellings of the digits provided.
+    static std::shared_ptr<Entry const> enumerate(std::string const& digits);
+
+    using recency_type = std::list<std::string>;
+
+    struct Slot {
+        std::shared_ptr<Entry const> entry;
+        recency_type::iterator       recency;
+    };
+
+    std::size_t                            capacity_,
+                                           bytes_ { 0 };
+    recency_type                           recency_;    // most recent first
+    std::unordered_map<std::string, Slot>  slots_;
+    mutable std::mutex                     mutex_;
+    std::atomic<std::uint64_t>             hits_   { 0 },
+                                           misses_ { 0 };
+};
+
+}
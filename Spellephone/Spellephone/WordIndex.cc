@@ -0,0 +1,387 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#include"WordIndex.h"
+#include"Keypad.h"
+#include"../../Common_Include/little_endian.h"
+using std::string;
+using std::vector;
+#include<algorithm>
+#include<cctype>
+#include<limits>
+
+namespace Spellephone {
+
+namespace {
+
+using little_endian::put;
+using little_endian::get;
+
+inline std::uint32_t get32(std::uint8_t const* in) {
+    return std::uint32_t(get(in, 4));
+}
+
+// The inverse of button_letters: the digit of each lower case letter, or 0.
+struct LetterDigits {
+    char digit[256];
+
+    LetterDigits() {
+        std::fill_n(digit, 256, '\0');
+        for(int button = 0; button < 10; ++button)
+            for(auto letter : button_letters[button])
+                if(std::isalpha((unsigned char)letter))
+                    digit[(unsigned char)letter] = char('0' + button);
+    }
+};
+
+// Built on first use, as button_letters is initialized in another
+// translation unit.
+inline char letter_digit(char letter) {
+    static LetterDigits const letter_digits;
+    return letter_digits.digit[(unsigned char)letter];
+}
+
+// FNV-1a, extended a digit at a time.
+std::uint64_t const hash_basis = 14695981039346656037ULL;
+
+inline std::uint64_t hash_step(std::uint64_t hash, char digit) {
+    return (hash ^ (unsigned char)digit) * 1099511628211ULL;
+}
+
+std::size_t const slot_bytes  = 8;
+std::size_t const group_bytes = 12;
+
+}
+
+// Write an index of the words provided.
+bool WordIndex::build(string const& path, vector<string> words) {
+
+    // Pair each word's digits with it, folding case.
+    vector<std::pair<string, string>> keyed;
+    std::size_t max_length = 0;
+
+    for(auto& word : words) {
+
+        string digits;
+        bool spelled = !word.empty();
+
+        for(auto& letter : word) {
+            letter = char(std::tolower((unsigned char)letter));
+            auto const digit = letter_digit(letter);
+            if(!digit) {
+                spelled = false;
+                break;
+            }
+            digits += digit;
+        }
+
+        if(spelled && word.size() <= std::numeric_limits<std::uint16_t>::max()) {
+            max_length = std::max(max_length, word.size());
+            keyed.emplace_back(std::move(digits), std::move(word));
+        }
+    }
+
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+
+    // The first word of each group.
+    vector<std::size_t> group_first;
+    for(std::size_t i = 0; i < keyed.size(); ++i)
+        if(!i || keyed[i].first != keyed[i - 1].first)
+            group_first.push_back(i);
+
+    std::uint64_t letter_bytes = 0;
+    for(auto const& entry : keyed)
+        letter_bytes += entry.second.size();
+
+    std::uint32_t slot_count = 2;
+    while(slot_count < group_first.size() * 2)
+        slot_count *= 2;
+
+    Header h{ magic, version, std::uint16_t(max_length)
+            , std::uint32_t(group_first.size()), std::uint32_t(keyed.size())
+            , slot_count, 0, letter_bytes };
+
+    auto const slots_offset   = header_bytes,
+               groups_offset  = slots_offset + slot_count * slot_bytes,
+               letters_offset = groups_offset + group_first.size() * group_bytes;
+
+    mapped_file out(path, letters_offset + letter_bytes);
+    if(!out.is_open())
+        return false;
+
+    auto const base = out.writable_data();
+
+    put(base, h.magic, 4);
+    put(base + 4, h.version, 2);
+    put(base + 6, h.max_length, 2);
+    put(base + 8, h.group_count, 4);
+    put(base + 12, h.word_count, 4);
+    put(base + 16, h.slot_count, 4);
+    put(base + 20, h.reserved, 4);
+    put(base + 24, h.letter_bytes, 8);
+
+    auto const slots = base + slots_offset;
+    std::fill_n(slots, slot_count * slot_bytes, std::uint8_t(0));
+
+    std::uint64_t letter = 0;
+
+    for(std::size_t group = 0; group < group_first.size(); ++group) {
+
+        auto const first = group_first[group],
+                   last  = group + 1 < group_first.size() ? group_first[group + 1]
+                                                          : keyed.size();
+        auto const& digits = keyed[first].first;
+
+        put(base + groups_offset + group * group_bytes, letter, 4);
+        put(base + groups_offset + group * group_bytes + 4, last - first, 4);
+        put(base + groups_offset + group * group_bytes + 8, digits.size(), 4);
+
+        for(auto i = first; i < last; ++i) {
+            std::copy( keyed[i].second.begin(), keyed[i].second.end()
+                     , base + letters_offset + letter);
+            letter += keyed[i].second.size();
+        }
+
+        // Probe linearly for a free slot.
+        auto hash = hash_basis;
+        for(auto digit : digits)
+            hash = hash_step(hash, digit);
+
+        auto slot = std::size_t(hash) & (slot_count - 1);
+        while(get32(slots + slot * slot_bytes + 4))
+            slot = (slot + 1) & (slot_count - 1);
+
+        put(slots + slot * slot_bytes, hash >> 32, 4);
+        put(slots + slot * slot_bytes + 4, group + 1, 4);
+    }
+
+    return out.flush();
+}
+
+// Map the file and validate its header.
+WordIndex::WordIndex(string const& path)
+: file_(path) {
+
+    if(file_.size() < header_bytes)
+        return;
+
+    auto const in = file_.data();
+
+    header_.magic        = get32(in);
+    header_.version      = std::uint16_t(get(in + 4, 2));
+    header_.max_length   = std::uint16_t(get(in + 6, 2));
+    header_.group_count  = get32(in + 8);
+    header_.word_count   = get32(in + 12);
+    header_.slot_count   = get32(in + 16);
+    header_.reserved     = get32(in + 20);
+    header_.letter_bytes = get(in + 24, 8);
+
+    auto const groups_offset  = header_bytes
+                              + std::uint64_t(header_.slot_count) * slot_bytes,
+               letters_offset = groups_offset
+                              + std::uint64_t(header_.group_count) * group_bytes;
+
+    bool const valid = header_.magic == magic
+                    && header_.version == version
+                    && header_.slot_count
+                    && !(header_.slot_count & (header_.slot_count - 1))
+                    && header_.group_count < header_.slot_count
+                    && letters_offset <= file_.size()
+                    && header_.letter_bytes <= file_.size() - letters_offset;
+
+    if(!valid)
+        return;
+
+    // Every slot must name a group, and every group its letters, within the
+    // file, as lookups follow them unchecked.
+    auto const slots  = in + header_bytes,
+               groups = in + groups_offset;
+
+    for(std::uint32_t slot = 0; slot < header_.slot_count; ++slot)
+        if(get32(slots + slot * slot_bytes + 4) > header_.group_count)
+            return;
+
+    for(std::uint32_t group = 0; group < header_.group_count; ++group) {
+
+        auto const record = groups + group * group_bytes;
+        auto const offset = std::uint64_t(get32(record)),
+                   count  = std::uint64_t(get32(record + 4)),
+                   length = std::uint64_t(get32(record + 8));
+
+        if(!count || !length || length > header_.max_length
+        || offset > header_.letter_bytes
+        || count * length > header_.letter_bytes - offset)
+            return;
+    }
+
+    slots_   = slots;
+    groups_  = groups;
+    letters_ = reinterpret_cast<char const*>(in + letters_offset);
+}
+
+// Visit each group spelled by a run of the digits from first onwards, hashing
+// one more digit for each longer run.
+template<typename Visit_>
+void WordIndex::prefixes(string const& digits, std::size_t first, Visit_ visit) const {
+
+    auto const mask = header_.slot_count - 1;
+    auto const last = std::min(digits.size(), first + header_.max_length);
+    auto hash = hash_basis;
+
+    for(auto end = first; end < last; ) {
+
+        hash = hash_step(hash, digits[end++]);
+        auto const length = end - first;
+
+        // A table with no empty slot is probed once around.
+        auto slot = std::size_t(hash) & mask;
+        for( std::size_t probes = 0; probes < header_.slot_count
+           ; ++probes, slot = (slot + 1) & mask) {
+
+            auto const entry = slots_ + slot * slot_bytes;
+            auto const group = get32(entry + 4);
+
+            if(!group)
+                break;
+
+            if(get32(entry) != std::uint32_t(hash >> 32))
+                continue;
+
+            auto const record = groups_ + (group - 1) * group_bytes;
+            if(get32(record + 8) != length)
+                continue;
+
+            // Confirm by spelling the group's first word back to digits.
+            auto const letters = letters_ + get32(record);
+            std::size_t i = 0;
+            while(i < length
+               && letter_digit(letters[i]) == digits[first + i])
+                ++i;
+
+            if(i == length) {
+                visit(Words{ letters, get32(record + 4), std::uint32_t(length) });
+                break;
+            }
+        }
+    }
+}
+
+bool WordIndex::find(Words& out, char const* digits, std::size_t length) const {
+
+    if(!is_open() || !length || length > header_.max_length)
+        return false;
+
+    string const run(digits, length);
+    bool found = false;
+
+    prefixes(run, 0, [&](Words const& words) {
+        if(words.length == length) {
+            out = words;
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+WordIndex::Words WordIndex::lookup(string const& phoneNumber) const {
+
+    string digits;
+    stripNondigits(digits, phoneNumber);
+
+    Words words{ nullptr, 0, 0 };
+    find(words, digits.data(), digits.size());
+    return words;
+}
+
+vector<WordIndex::Match> WordIndex::substrings(string const& phoneNumber) const {
+
+    string digits;
+    stripNondigits(digits, phoneNumber);
+
+    vector<Match> matches;
+
+    if(is_open())
+        for(std::size_t first = 0; first < digits.size(); ++first)
+            prefixes(digits, first, [&](Words const& words) {
+                matches.push_back(Match{ first, words });
+            });
+
+    return matches;
+}
+
+vector<WordIndex::Segmentation>
+WordIndex::segmentations(string const& phoneNumber, std::size_t limit) const {
+
+    string digits;
+    stripNondigits(digits, phoneNumber);
+
+    vector<Segmentation> result;
+    if(!is_open() || digits.empty() || !limit)
+        return result;
+
+    auto const size = digits.size();
+    auto const none = std::numeric_limits<std::size_t>::max();
+
+    // The words starting at each position, and the fewest words spelling
+    // everything from each position on.
+    vector<vector<Words>> starting(size);
+    vector<std::size_t> fewest(size + 1, none);
+    fewest[size] = 0;
+
+    for(auto first = size; first--; )
+        prefixes(digits, first, [&](Words const& words) {
+            starting[first].push_back(words);
+            auto const rest = fewest[first + words.length];
+            if(rest != none)
+                fewest[first] = std::min(fewest[first], rest + 1);
+        });
+
+    if(fewest[0] == none)
+        return result;
+
+    // Walk depth first along the steps keeping to the fewest words.
+    Segmentation path;
+
+    auto const walk = [&](std::size_t first, auto const& self) -> void {
+
+        if(first == size) {
+            result.push_back(path);
+            return;
+        }
+
+        for(auto const& words : starting[first]) {
+
+            if(result.size() == limit)
+                return;
+
+            auto const next = first + words.length;
+            if(fewest[next] == none || fewest[next] + 1 != fewest[first])
+                continue;
+
+            path.push_back(Match{ first, words });
+            self(next, self);
+            path.pop_back();
+        }
+    };
+
+    walk(0, walk);
+    return result;
+}
+
+}
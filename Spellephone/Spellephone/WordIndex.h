@@ -0,0 +1,122 @@
+// Copyright 2016 Frank Plochan
+//
+// This file is part of Spellephone.
+//
+// Spellephone is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spellephone is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+#include"../../Common_Include/mapped_file.h"
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+
+namespace Spellephone {
+
+// A file indexing dictionary words by the digits that spell them, so the
+// words a phone number spells are found without enumerating its spellings.
+// Words with the same digits are stored together, and a hash table over the
+// digit strings finds them.  The file is memory mapped and used in place.
+//
+// Layout, all integers little endian:
+//  header  - see WordIndex::Header below
+//  slots   - slot_count (a power of two) pairs of 32-bit words: the upper
+//            half of the digits' hash and 1 + the group index, 0 if empty
+//  groups  - group_count triples of 32-bit words: offset into letters, word
+//            count and word length
+//  letters - each group's words, one after another, without separators
+class WordIndex {
+public:
+
+    static std::uint32_t const magic   = 0x49575053;   // "SPWI"
+    static std::uint16_t const version = 1;
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t max_length;       // the longest word
+        std::uint32_t group_count;
+        std::uint32_t word_count;
+        std::uint32_t slot_count;
+        std::uint32_t reserved;
+        std::uint64_t letter_bytes;
+    };
+
+    static std::size_t const header_bytes = 32;
+
+    // The words spelled by one digit string, each length letters.
+    struct Words {
+        char const*   letters;
+        std::uint32_t count;
+        std::uint32_t length;
+
+        std::string operator[](std::uint32_t i) const {
+            return std::string(letters + std::size_t(i) * length, length);
+        }
+    };
+
+    // A word group found within a digit string.
+    struct Match {
+        std::size_t position;           // in the digits, not the phone number
+        Words       words;
+    };
+
+    // Words covering a digit string end to end, one group per word.
+    using Segmentation = std::vector<Match>;
+
+    // Write an index of the words provided.  Letters are folded to lower
+    // case; words with any character not on a button, and duplicates, are
+    // left out.  Returns false on an I/O failure.
+    static bool build(std::string const& path, std::vector<std::string> words);
+
+    // Map an index file.
+    explicit WordIndex(std::string const& path);
+
+    // Test that the file was mapped and holds a valid index.
+    bool is_open() const { return slots_ != nullptr; }
+
+    Header const& info() const { return header_; }
+
+    // Find the words spelled by exactly the length digits given.  Returns
+    // false when there are none.
+    bool find(Words& out, char const* digits, std::size_t length) const;
+
+    // The words spelled by all of the phone number's digits.
+    Words lookup(std::string const& phoneNumber) const;
+
+    // Every word spelled by a run of the phone number's digits, by position
+    // and then length.
+    std::vector<Match> substrings(std::string const& phoneNumber) const;
+
+    // The ways to spell all of the phone number's digits with the fewest
+    // words, up to limit of them.  Shortest word counts to the end of the
+    // digits are found from the last digit back; the segmentations then
+    // follow only steps keeping to them.
+    std::vector<Segmentation>
+    segmentations(std::string const& phoneNumber, std::size_t limit = 16) const;
+
+private:
+
+    // Visit each group spelled by digits [first..first + n) for every n.
+    template<typename Visit_>
+    void prefixes(std::string const& digits, std::size_t first, Visit_ visit) const;
+
+    Header              header_;
+    mapped_file         file_;
+    std::uint8_t const* slots_   { nullptr };
+    std::uint8_t const* groups_  { nullptr };
+    char const*         letters_ { nullptr };
+};
+
+}
@@ -16,14 +16,78 @@
 // along with Spellephone.  If not, see <http://www.gnu.org/licenses/>.
 
 #include"PhoneNumberEnumerator.h"
+#include"WordIndex.h"
 #include<iostream>
+#include<fstream>
+#include<vector>
 using std::cout;
 #include<string>
 using std::string;
+#include"../../Common_Include/instrumentation.h"
+
+// Write a word index from a word list, one word per line.
+//   index <word list> <index>
+int index(char** argv) {
+
+    std::ifstream in(argv[2]);
+    if(!in) {
+        std::cerr << "Failed to read " << argv[2] << '\n';
+        return -1;
+    }
+
+    std::vector<string> words;
+    for(string word; std::getline(in, word); )
+        words.push_back(word);
+
+    if(!Spellephone::WordIndex::build(argv[3], std::move(words))) {
+        std::cerr << "Failed to write " << argv[3] << '\n';
+        return -1;
+    }
+
+    return 0;
+}
+
+// Show the words a phone number spells, in whole, in part and as a sequence.
+//   words <index> <phone number>
+int words(char** argv) {
+
+    Spellephone::WordIndex const index(argv[2]);
+    if(!index.is_open()) {
+        std::cerr << "Failed to read " << argv[2] << '\n';
+        return -1;
+    }
+
+    auto const show = [](Spellephone::WordIndex::Words const& words) {
+        for(std::uint32_t i = 0; i < words.count; ++i)
+            cout << (i ? "|" : "") << words[i];
+    };
+
+    for(auto const& match : index.substrings(argv[3])) {
+        cout << match.position << ' ';
+        show(match.words);
+        cout << '\n';
+    }
+
+    for(auto const& segmentation : index.segmentations(argv[3])) {
+        for(auto const& match : segmentation) {
+            show(match.words);
+            cout << ' ';
+        }
+        cout << '\n';
+    }
+
+    return 0;
+}
 
 // Program entry point.
 int main(int argc, char** argv) {
 
+    if(4 == argc && string(argv[1]) == "index")
+        return index(argv);
+
+    if(4 == argc && string(argv[1]) == "words")
+        return words(argv);
+
     if(2 != argc) {
         std::cerr << "Must supply one argument\n";
         return -1;
@@ -41,5 +105,6 @@ int main(int argc, char** argv) {
     for(string perm = enumerator.next(); perm.size(); perm = enumerator.next())
         cout << perm << '\n';
 
+    INSTRUMENT_REPORT(std::cerr);
     return 0;
 }